@@ -0,0 +1,201 @@
+/*!
+ * @file Adafruit_Compositor_SR.cpp
+ *
+ * Layer composition for Adafruit_SPITFT displays: each damaged area is
+ * rebuilt a band of scanlines at a time, bottom layer to top, and
+ * streamed to the display in one address window.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_Compositor_SR.h"
+
+/**************************************************************************/
+/*!
+   @brief    Create a compositor
+   @param    display  Display to push frames to
+   @param    band     Canvas each damaged area is built in, e.g. a screen
+                      wide strip of 8-16 rows. Wider areas are split. It
+                      is set to rotation 0, and big-endian mode (see
+                      GFXcanvas16::setBigEndian()) makes pushes cheaper.
+*/
+/**************************************************************************/
+Adafruit_Compositor::Adafruit_Compositor(Adafruit_SPITFT *display,
+                                         GFXcanvas16 *band)
+    : display(display), band(band), backgroundColor(0), numLayers(0) {
+  band->setRotation(0);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Put a layer on top of the stack; it appears on the next
+             update()
+   @param    layer  Layer to add, with canvas or render, position etc.
+                    filled in
+   @returns  false if the stack is full or the layer has no content
+*/
+/**************************************************************************/
+bool Adafruit_Compositor::addLayer(GFXlayer *layer) {
+  if ((!layer->canvas && !layer->render) ||
+      (numLayers >= COMPOSITOR_MAX_LAYERS))
+    return false;
+  layers[numLayers++] = layer;
+  invalidateLayer(layer);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Set the color shown where no layer covers the screen
+   @param    color  16-bit 5-6-5 color
+*/
+/**************************************************************************/
+void Adafruit_Compositor::setBackgroundColor(uint16_t color) {
+  backgroundColor = color;
+  invalidateAll();
+}
+
+/**************************************************************************/
+/*!
+   @brief    Move a layer, repainting its old and new areas
+   @param    layer  Layer to move
+   @param    x      New left edge on screen
+   @param    y      New top edge on screen
+*/
+/**************************************************************************/
+void Adafruit_Compositor::moveLayer(GFXlayer *layer, int16_t x, int16_t y) {
+  invalidateLayer(layer);
+  layer->x = x;
+  layer->y = y;
+  invalidateLayer(layer);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Hide or show a layer without removing it
+   @param    layer    Layer to change
+   @param    visible  true to show, false to hide
+*/
+/**************************************************************************/
+void Adafruit_Compositor::showLayer(GFXlayer *layer, bool visible) {
+  if (layer->visible != visible) {
+    layer->visible = visible;
+    invalidateLayer(layer);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Report that a layer's whole content changed. For a smaller
+             change, pass just the affected screen area to invalidate().
+   @param    layer  Layer that changed
+*/
+/**************************************************************************/
+void Adafruit_Compositor::invalidateLayer(GFXlayer *layer) {
+  GFXrect r;
+  layerBounds(layer, &r);
+  damage.add(r.x, r.y, r.w, r.h);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Report that something in a screen area changed
+   @param    x  Left edge, on screen
+   @param    y  Top edge, on screen
+   @param    w  Width
+   @param    h  Height
+*/
+/**************************************************************************/
+void Adafruit_Compositor::invalidate(int16_t x, int16_t y, int16_t w,
+                                     int16_t h) {
+  damage.add(x, y, w, h);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Repaint the whole screen on the next update()
+*/
+/**************************************************************************/
+void Adafruit_Compositor::invalidateAll(void) {
+  damage.add(0, 0, display->width(), display->height());
+}
+
+/**************************************************************************/
+/*!
+   @brief    Recomposite and push every area damaged since the last call
+*/
+/**************************************************************************/
+void Adafruit_Compositor::update(void) {
+  display->pushDamage(damage, band, composeBand, this);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Get the screen area a layer covers
+   @param    layer  Layer to measure
+   @param    r      Receives the area
+*/
+/**************************************************************************/
+void Adafruit_Compositor::layerBounds(const GFXlayer *layer,
+                                      GFXrect *r) const {
+  r->x = layer->x;
+  r->y = layer->y;
+  r->w = layer->canvas ? layer->canvas->width() : layer->w;
+  r->h = layer->canvas ? layer->canvas->height() : layer->h;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Rebuild one band of a damaged area for pushDamage(), bottom
+             layer to top. Canvas layers are copied row by row (keyed ones
+             skip their key color); display-list layers draw straight into
+             the band, clipped to their own w x h.
+   @param    band  Band canvas; its (0,0) is screen (x,y)
+   @param    x     Left edge, on screen
+   @param    y     Top edge, on screen
+   @param    w     Width to fill
+   @param    h     Height to fill
+   @param    arg   The Adafruit_Compositor
+*/
+/**************************************************************************/
+void Adafruit_Compositor::composeBand(GFXcanvas16 *band, int16_t x,
+                                      int16_t y, int16_t w, int16_t h,
+                                      void *arg) {
+  Adafruit_Compositor *comp = (Adafruit_Compositor *)arg;
+  bool covered = false; // Band filled by an opaque layer yet?
+  for (uint8_t i = 0; i < comp->numLayers; i++) {
+    GFXlayer *l = comp->layers[i];
+    GFXrect r;
+    comp->layerBounds(l, &r);
+    if (!l->visible || (r.x >= x + w) || (r.y >= y + h) ||
+        (r.x + r.w <= x) || (r.y + r.h <= y))
+      continue; // Hidden, or not in this band
+    if (!covered) {
+      // Nothing below yet: start from the background color, unless this
+      // layer is opaque and fills the band by itself
+      if (l->keyed || !l->canvas || (r.x > x) || (r.y > y) ||
+          (r.x + r.w < x + w) || (r.y + r.h < y + h)) {
+        for (int16_t j = 0; j < h; j++)
+          band->drawFastHLine(0, j, w, comp->backgroundColor);
+      }
+      covered = true;
+    }
+    if (!l->canvas) {
+      band->pushClipRect(r.x - x, r.y - y, r.w, r.h);
+      l->render(band, x, y, l->arg);
+      band->popClipRect();
+    } else if (l->keyed) {
+      band->blitKeyed(l->canvas, x - r.x, y - r.y, w, h, 0, 0, l->key);
+    } else {
+      band->blit(l->canvas, x - r.x, y - r.y, w, h, 0, 0);
+    }
+  }
+  if (!covered) {
+    for (int16_t j = 0; j < h; j++)
+      band->drawFastHLine(0, j, w, comp->backgroundColor);
+  }
+}
+
+#endif // end __AVR_ATtiny85__
@@ -0,0 +1,81 @@
+/*!
+ * @file Adafruit_Compositor_SR.h
+ *
+ * Part of Adafruit's GFX graphics library. A compositor stacks several
+ * layers on an Adafruit_SPITFT display (e.g. Adafruit_ILI9341): cached
+ * canvases such as a static background, and display-list layers that
+ * redraw themselves with GFX primitives on request. Only damaged areas are
+ * recomposited, a band of scanlines at a time, and streamed to the
+ * display; cached layers cost a row copy instead of re-running the
+ * primitives that made them.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_COMPOSITOR_H_
+#define _ADAFRUIT_COMPOSITOR_H_
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_GFX_SR.h"
+#include "Adafruit_SPITFT_SR.h"
+
+#ifndef COMPOSITOR_MAX_LAYERS
+#define COMPOSITOR_MAX_LAYERS 8 ///< Layers one compositor can stack
+#endif
+
+/*!
+  @brief  Draws a display-list layer into one band of the screen
+  @param  band  Canvas to draw into; its (0,0) is screen (x0,y0)
+  @param  x0    Screen column of the band's left edge
+  @param  y0    Screen row of the band's top edge
+  @param  arg   The layer's arg pointer
+*/
+typedef void (*GFXlayerRender)(GFXcanvas16 *band, int16_t x0, int16_t y0,
+                               void *arg);
+
+/// One layer of an Adafruit_Compositor. The caller owns the storage;
+/// change it only through the compositor so damage is tracked.
+typedef struct {
+  GFXcanvas16 *canvas;   ///< Cached pixels, or NULL for a display list
+  GFXlayerRender render; ///< Display-list drawing function if no canvas
+  void *arg;             ///< Passed to render
+  int16_t x;             ///< Left edge on screen
+  int16_t y;             ///< Top edge on screen
+  int16_t w;             ///< Display list width, drawing is clipped to it
+                         ///< (canvas layers: ignored)
+  int16_t h;             ///< Display list height, likewise
+  uint16_t key;          ///< Transparent color, used if keyed is set
+  bool keyed;            ///< true if key marks transparent canvas pixels
+  bool visible;          ///< false to hide without removing
+} GFXlayer;
+
+/// Composites a stack of layers and pushes only damaged areas
+class Adafruit_Compositor {
+public:
+  Adafruit_Compositor(Adafruit_SPITFT *display, GFXcanvas16 *band);
+
+  bool addLayer(GFXlayer *layer);
+  void setBackgroundColor(uint16_t color);
+  void moveLayer(GFXlayer *layer, int16_t x, int16_t y);
+  void showLayer(GFXlayer *layer, bool visible);
+  void invalidateLayer(GFXlayer *layer);
+  void invalidate(int16_t x, int16_t y, int16_t w, int16_t h);
+  void invalidateAll(void);
+  void update(void);
+
+protected:
+  void layerBounds(const GFXlayer *layer, GFXrect *r) const;
+  static void composeBand(GFXcanvas16 *band, int16_t x, int16_t y, int16_t w,
+                          int16_t h, void *arg);
+
+  Adafruit_SPITFT *display;               ///< Where frames are pushed
+  GFXcanvas16 *band;                      ///< Composition buffer
+  uint16_t backgroundColor;               ///< Where no layer covers
+  GFXlayer *layers[COMPOSITOR_MAX_LAYERS]; ///< Bottom to top
+  uint8_t numLayers;                      ///< Entries used in layers[]
+  GFXdamage damage;                       ///< Areas to repaint
+};
+
+#endif // end __AVR_ATtiny85__
+#endif // end _ADAFRUIT_COMPOSITOR_H_
@@ -38,6 +38,14 @@ POSSIBILITY OF SUCH DAMAGE.
 #elif defined(ESP8266) || defined(ESP32)
 #include <pgmspace.h>
 #endif
+#if defined(ESP32)
+#include <esp_heap_caps.h>
+#if __has_include(<esp_memory_utils.h>)
+#include <esp_memory_utils.h> // esp_ptr_external_ram(), IDF 5
+#else
+#include <soc/soc_memory_layout.h> // Same, IDF 4
+#endif
+#endif
 
 // Many (but maybe not all) non-AVR board installs define macros
 // for compatibility with existing PROGMEM-reading AVR code.
@@ -117,11 +125,14 @@ Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {
   wrap = true;
   _cp437 = false;
   gfxFont = NULL;
+  resetViewport();
 }
 
 /**************************************************************************/
 /*!
-   @brief    Write a line.  Bresenham's algorithm - thx wikpedia
+   @brief    Write a line.  Bresenham's algorithm - thx wikpedia. Drawn as
+   runs by polyLine(), so displays get one address window per run rather
+   than per pixel.
     @param    x0  Start point x coordinate
     @param    y0  Start point y coordinate
     @param    x1  End point x coordinate
@@ -131,45 +142,9 @@ Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {
 /**************************************************************************/
 void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
                              uint16_t color) {
-#if defined(ESP8266)
-  yield();
-#endif
-  int16_t steep = abs(y1 - y0) > abs(x1 - x0);
-  if (steep) {
-    _swap_int16_t(x0, y0);
-    _swap_int16_t(x1, y1);
-  }
-
-  if (x0 > x1) {
-    _swap_int16_t(x0, x1);
-    _swap_int16_t(y0, y1);
-  }
-
-  int16_t dx, dy;
-  dx = x1 - x0;
-  dy = abs(y1 - y0);
-
-  int16_t err = dx / 2;
-  int16_t ystep;
-
-  if (y0 < y1) {
-    ystep = 1;
-  } else {
-    ystep = -1;
-  }
-
-  for (; x0 <= x1; x0++) {
-    if (steep) {
-      writePixel(y0, x0, color);
-    } else {
-      writePixel(x0, y0, color);
-    }
-    err -= dy;
-    if (err < 0) {
-      y0 += ystep;
-      err += dx;
-    }
-  }
+  GFXrect run = {0, 0, 0, 0};
+  polyLine(x0, y0, x1, y1, false, false, &run, color);
+  polyRun(&run, 0, 0, 0, 0, color);
 }
 
 /**************************************************************************/
@@ -264,8 +239,17 @@ void Adafruit_GFX::endWrite() {}
 /**************************************************************************/
 void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h,
                                  uint16_t color) {
+  // Pixel by pixel: writeLine() hands its runs to writeFastVLine(), which
+  // lands back here unless a subclass overrides it. Same end points as
+  // writeLine(x, y, x, y + h - 1).
+  int16_t y1 = y + h - 1;
+  if (y1 < y)
+    _swap_int16_t(y, y1);
+  if (clipReject(x, y, 1, y1 - y + 1))
+    return;
   startWrite();
-  writeLine(x, y, x, y + h - 1, color);
+  for (int32_t i = y; i <= y1; i++)
+    writePixel(x, i, color);
   endWrite();
 }
 
@@ -281,8 +265,15 @@ void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h,
 /**************************************************************************/
 void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w,
                                  uint16_t color) {
+  // Pixel by pixel, as in drawFastVLine()
+  int16_t x1 = x + w - 1;
+  if (x1 < x)
+    _swap_int16_t(x, x1);
+  if (clipReject(x, y, x1 - x + 1, 1))
+    return;
   startWrite();
-  writeLine(x, y, x + w - 1, y, color);
+  for (int32_t i = x; i <= x1; i++)
+    writePixel(i, y, color);
   endWrite();
 }
 
@@ -299,6 +290,12 @@ void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w,
 /**************************************************************************/
 void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                             uint16_t color) {
+  if (w < 0) { // Negative width extends left, as on the display drivers
+    x += w + 1;
+    w = -w;
+  }
+  if (clipReject(x, y, w, h))
+    return;
   startWrite();
   for (int16_t i = x; i < x + w; i++) {
     writeFastVLine(i, y, h, color);
@@ -308,13 +305,14 @@ void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
 
 /**************************************************************************/
 /*!
-   @brief    Fill the screen completely with one color. Update in subclasses if
-   desired!
+   @brief    Fill the screen (or viewport and clip rectangle, if set)
+   completely with one color. Update in subclasses if desired!
     @param    color 16-bit 5-6-5 Color to fill with
 */
 /**************************************************************************/
 void Adafruit_GFX::fillScreen(uint16_t color) {
-  fillRect(0, 0, _width, _height, color);
+  GFXrect r = getClipRect();
+  fillRect(r.x, r.y, r.w, r.h, color);
 }
 
 /**************************************************************************/
@@ -345,6 +343,41 @@ void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
   }
 }
 
+/**************************************************************************/
+/*!
+   @brief    Draw many single pixels of one color, e.g. the points of a
+             scatter plot. Update in subclasses if desired: displays can
+             sort the points and send neighbors together.
+    @param    points  Pixel positions, in any order
+    @param    n       Number of points
+    @param    color   16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawPixels(const GFXpoint *points, uint16_t n,
+                              uint16_t color) {
+  startWrite();
+  for (uint16_t i = 0; i < n; i++)
+    writePixel(points[i].x, points[i].y, color);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw many single pixels, each its own color. Where a position
+             repeats, the later point wins.
+    @param    points  Pixel positions, in any order
+    @param    colors  16-bit 5-6-5 Color of each point
+    @param    n       Number of points
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawPixels(const GFXpoint *points, const uint16_t *colors,
+                              uint16_t n) {
+  startWrite();
+  for (uint16_t i = 0; i < n; i++)
+    writePixel(points[i].x, points[i].y, colors[i]);
+  endWrite();
+}
+
 /**************************************************************************/
 /*!
    @brief    Draw a circle outline
@@ -359,17 +392,26 @@ void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r,
 #if defined(ESP8266)
   yield();
 #endif
+  if ((r < 0) || clipReject(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1))
+    return;
+  startWrite();
+  if (r < 2) { // Just the four axis points (or one)
+    writePixel(x0, y0 + r, color);
+    if (r) {
+      writePixel(x0, y0 - r, color);
+      writePixel(x0 + r, y0, color);
+      writePixel(x0 - r, y0, color);
+    }
+    endWrite();
+    return;
+  }
+
   int16_t f = 1 - r;
   int16_t ddF_x = 1;
   int16_t ddF_y = -2 * r;
   int16_t x = 0;
   int16_t y = r;
-
-  startWrite();
-  writePixel(x0, y0 + r, color);
-  writePixel(x0, y0 - r, color);
-  writePixel(x0 + r, y0, color);
-  writePixel(x0 - r, y0, color);
+  int16_t xs = 0; // First x of the current run; the axis points start one
 
   while (x < y) {
     if (f >= 0) {
@@ -380,15 +422,10 @@ void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r,
     x++;
     ddF_x += 2;
     f += ddF_x;
-
-    writePixel(x0 + x, y0 + y, color);
-    writePixel(x0 - x, y0 + y, color);
-    writePixel(x0 + x, y0 - y, color);
-    writePixel(x0 - x, y0 - y, color);
-    writePixel(x0 + y, y0 + x, color);
-    writePixel(x0 - y, y0 + x, color);
-    writePixel(x0 + y, y0 - x, color);
-    writePixel(x0 - y, y0 - x, color);
+    if ((x >= y) || (f >= 0)) { // Last point on this row (or of octant)
+      circleRun(x0, y0, xs, x, y, 0xF, color);
+      xs = x + 1;
+    }
   }
   endWrite();
 }
@@ -411,6 +448,7 @@ void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r,
   int16_t ddF_y = -2 * r;
   int16_t x = 0;
   int16_t y = r;
+  int16_t xs = 1; // First x of the current run
 
   while (x < y) {
     if (f >= 0) {
@@ -421,25 +459,58 @@ void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r,
     x++;
     ddF_x += 2;
     f += ddF_x;
-    if (cornername & 0x4) {
-      writePixel(x0 + x, y0 + y, color);
-      writePixel(x0 + y, y0 + x, color);
-    }
-    if (cornername & 0x2) {
-      writePixel(x0 + x, y0 - y, color);
-      writePixel(x0 + y, y0 - x, color);
-    }
-    if (cornername & 0x8) {
-      writePixel(x0 - y, y0 + x, color);
-      writePixel(x0 - x, y0 + y, color);
-    }
-    if (cornername & 0x1) {
-      writePixel(x0 - y, y0 - x, color);
-      writePixel(x0 - x, y0 - y, color);
+    if ((x >= y) || (f >= 0)) { // Last point on this row (or of octant)
+      circleRun(x0, y0, xs, x, y, cornername, color);
+      xs = x + 1;
     }
   }
 }
 
+/**************************************************************************/
+/*!
+    @brief    Write one run of a circle outline: points (xa..xb, y) of the
+              octant next to the vertical axis, which share a row, mirrored
+              into the selected quarters as horizontal lines, plus their
+              reflections about the diagonal as vertical lines.
+    @param    x0       Center-point x coordinate
+    @param    y0       Center-point y coordinate
+    @param    xa       First x offset of the run; 0 for the run through the
+                       axis points of a full circle, written as single lines
+                       across both halves
+    @param    xb       Last x offset of the run
+    @param    y        y offset shared by the run
+    @param    corners  Quarters to draw, as in drawCircleHelper()
+    @param    color    16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_GFX::circleRun(int16_t x0, int16_t y0, int16_t xa, int16_t xb,
+                             int16_t y, uint8_t corners, uint16_t color) {
+  if (!xa) { // Full circle, top and bottom rows and side columns
+    writeFastHLine(x0 - xb, y0 - y, 2 * xb + 1, color);
+    writeFastHLine(x0 - xb, y0 + y, 2 * xb + 1, color);
+    writeFastVLine(x0 - y, y0 - xb, 2 * xb + 1, color);
+    writeFastVLine(x0 + y, y0 - xb, 2 * xb + 1, color);
+    return;
+  }
+  int16_t n = xb - xa + 1;
+  if (corners & 0x4) {
+    writeFastHLine(x0 + xa, y0 + y, n, color);
+    writeFastVLine(x0 + y, y0 + xa, n, color);
+  }
+  if (corners & 0x2) {
+    writeFastHLine(x0 + xa, y0 - y, n, color);
+    writeFastVLine(x0 + y, y0 - xb, n, color);
+  }
+  if (corners & 0x8) {
+    writeFastVLine(x0 - y, y0 + xa, n, color);
+    writeFastHLine(x0 - xb, y0 + y, n, color);
+  }
+  if (corners & 0x1) {
+    writeFastVLine(x0 - y, y0 - xb, n, color);
+    writeFastHLine(x0 - xb, y0 - y, n, color);
+  }
+}
+
 /**************************************************************************/
 /*!
    @brief    Draw a circle with filled color
@@ -451,10 +522,8 @@ void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r,
 /**************************************************************************/
 void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r,
                               uint16_t color) {
-  startWrite();
-  writeFastVLine(x0, y0 - r, 2 * r + 1, color);
-  fillCircleHelper(x0, y0, r, 3, 0, color);
-  endWrite();
+  if (r >= 0) // A round rect that is all corners
+    fillRoundRect(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1, r, color);
 }
 
 /**************************************************************************/
@@ -522,6 +591,8 @@ void Adafruit_GFX::fillCircleHelper(int16_t x0, int16_t y0, int16_t r,
 /**************************************************************************/
 void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
                             uint16_t color) {
+  if (clipReject(x, y, w, h))
+    return;
   startWrite();
   writeFastHLine(x, y, w, color);
   writeFastHLine(x, y + h - 1, w, color);
@@ -543,6 +614,8 @@ void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
 /**************************************************************************/
 void Adafruit_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
                                  int16_t r, uint16_t color) {
+  if (clipReject(x, y, w, h))
+    return;
   int16_t max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
   if (r > max_radius)
     r = max_radius;
@@ -573,18 +646,114 @@ void Adafruit_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
 /**************************************************************************/
 void Adafruit_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
                                  int16_t r, uint16_t color) {
+  if ((w <= 0) || (h <= 0) || clipReject(x, y, w, h))
+    return;
   int16_t max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
   if (r > max_radius)
     r = max_radius;
-  // smarter version
+  if (r < 0)
+    r = 0;
+  // One rectangle for the straight middle, then one span per row above
+  // and below it: every pixel is sent once. Same shape as the classic
+  // fillCircleHelper() columns, walked by row instead.
   startWrite();
-  writeFillRect(x + r, y, w - 2 * r, h, color);
-  // draw four corners
-  fillCircleHelper(x + w - r - 1, y + r, r, 1, h - 2 * r - 1, color);
-  fillCircleHelper(x + r, y + r, r, 2, h - 2 * r - 1, color);
+  if (h > 2 * r)
+    writeFillRect(x, y + r, w, h - 2 * r, color);
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t cx = 0;
+  int16_t cy = r;
+  int16_t xs = 1; // First x of the current run
+  int16_t tv = 0; // Last row filled out to cy, below the diagonal
+
+  if ((r > 0) && (f >= 0)) // Radius 1: no run on the top row
+    fillRoundRows(x, y, w, h, r, r, r, 0, color);
+  while (cx < cy) {
+    if (f >= 0) {
+      cy--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    cx++;
+    ddF_x += 2;
+    f += ddF_x;
+    if ((cx >= cy) || (f >= 0)) { // Last point on this row (or of octant)
+      // Octant points (xs..cx, cy) make row cy; their mirrors about the
+      // diagonal reach out to cy on rows xs..cx. Near the diagonal the
+      // two can meet; each row is written once.
+      if (cy > tv)
+        fillRoundRows(x, y, w, h, r, cy, cy, cx, color);
+      int16_t t1 = (cx < cy) ? cx : cy - 1;
+      fillRoundRows(x, y, w, h, r, xs, t1, cy, color);
+      if (t1 > tv)
+        tv = t1;
+      xs = cx + 1;
+    }
+  }
   endWrite();
 }
 
+/**************************************************************************/
+/*!
+   @brief   Write rows of fillRoundRect()'s rounded ends, one span each
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    w   Width in pixels
+    @param    h   Height in pixels
+    @param    r   Radius of corner rounding, already limited to fit
+    @param    t0  First row, counted up (and down) from the corner centers
+    @param    t1  Last row, same count; nothing is drawn if below t0
+    @param    dx  How far the rows reach past the corner centers
+    @param    color 16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void Adafruit_GFX::fillRoundRows(int16_t x, int16_t y, int16_t w, int16_t h,
+                                 int16_t r, int16_t t0, int16_t t1, int16_t dx,
+                                 uint16_t color) {
+  int16_t xl = x + r - dx, len = w - 2 * r + 2 * dx;
+  if (len <= 0)
+    return;
+  for (int16_t t = t0; t <= t1; t++) {
+    writeFastHLine(xl, y + r - t, len, color);
+    writeFastHLine(xl, y + h - r - 1 + t, len, color);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Test a triangle's bounding box against the clip rectangle
+    @param    x0  Vertex #0 x coordinate
+    @param    y0  Vertex #0 y coordinate
+    @param    x1  Vertex #1 x coordinate
+    @param    y1  Vertex #1 y coordinate
+    @param    x2  Vertex #2 x coordinate
+    @param    y2  Vertex #2 y coordinate
+    @returns  true if the triangle is entirely clipped
+*/
+/**************************************************************************/
+bool Adafruit_GFX::triangleReject(int16_t x0, int16_t y0, int16_t x1,
+                                  int16_t y1, int16_t x2, int16_t y2) const {
+  int16_t xa = x0, xb = x0, ya = y0, yb = y0;
+  if (x1 < xa)
+    xa = x1;
+  if (x1 > xb)
+    xb = x1;
+  if (x2 < xa)
+    xa = x2;
+  if (x2 > xb)
+    xb = x2;
+  if (y1 < ya)
+    ya = y1;
+  if (y1 > yb)
+    yb = y1;
+  if (y2 < ya)
+    ya = y2;
+  if (y2 > yb)
+    yb = y2;
+  return clipReject(xa, ya, xb - xa + 1, yb - ya + 1);
+}
+
 /**************************************************************************/
 /*!
    @brief   Draw a triangle with no fill color
@@ -599,6 +768,8 @@ void Adafruit_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
 /**************************************************************************/
 void Adafruit_GFX::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
                                 int16_t x2, int16_t y2, uint16_t color) {
+  if (triangleReject(x0, y0, x1, y1, x2, y2))
+    return;
   drawLine(x0, y0, x1, y1, color);
   drawLine(x1, y1, x2, y2, color);
   drawLine(x2, y2, x0, y0, color);
@@ -619,6 +790,9 @@ void Adafruit_GFX::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
 void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
                                 int16_t x2, int16_t y2, uint16_t color) {
 
+  if (triangleReject(x0, y0, x1, y1, x2, y2))
+    return;
+
   int16_t a, b, y, last;
 
   // Sort coordinates by Y order (y2 >= y1 >= y0)
@@ -700,171 +874,391 @@ void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
   endWrite();
 }
 
-// BITMAP / XBITMAP / GRAYSCALE / RGB BITMAP FUNCTIONS ---------------------
-
 /**************************************************************************/
 /*!
-   @brief      Draw a PROGMEM-resident 1-bit image at the specified (x,y)
-   position, using the specified foreground color (unset bits are transparent).
-    @param    x   Top left corner x coordinate
-    @param    y   Top left corner y coordinate
-    @param    bitmap  byte array with monochrome bitmap
-    @param    w   Width of bitmap in pixels
-    @param    h   Height of bitmap in pixels
-    @param    color 16-bit 5-6-5 Color to draw with
+   @brief     Draw connected lines through a list of points, e.g. a chart
+              trace, in one write transaction. Joints are drawn once, and
+              runs that continue from one segment into the next (a flat
+              stretch of data) go out as a single fast line.
+    @param    points  Vertices in order
+    @param    n       Number of vertices
+    @param    color   16-bit 5-6-5 Color to draw with
 */
 /**************************************************************************/
-void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
-                              int16_t w, int16_t h, uint16_t color) {
-
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t b = 0;
-
+void Adafruit_GFX::drawPolyline(const GFXpoint *points, uint16_t n,
+                                uint16_t color) {
+  if (!n)
+    return;
+  GFXrect run = {0, 0, 0, 0}; // Nothing pending
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        b <<= 1;
-      else
-        b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
-      if (b & 0x80)
-        writePixel(x + i, y, color);
-    }
-  }
+  if (n == 1)
+    polyRun(&run, points[0].x, points[0].y, 1, 1, color);
+  for (uint16_t i = 0; i + 1 < n; i++)
+    polyLine(points[i].x, points[i].y, points[i + 1].x, points[i + 1].y,
+             i > 0, false, &run, color);
+  polyRun(&run, 0, 0, 0, 0, color);
   endWrite();
 }
 
 /**************************************************************************/
 /*!
-   @brief      Draw a PROGMEM-resident 1-bit image at the specified (x,y)
-   position, using the specified foreground (for set bits) and background (unset
-   bits) colors.
-    @param    x   Top left corner x coordinate
-    @param    y   Top left corner y coordinate
-    @param    bitmap  byte array with monochrome bitmap
-    @param    w   Width of bitmap in pixels
-    @param    h   Height of bitmap in pixels
-    @param    color 16-bit 5-6-5 Color to draw pixels with
-    @param    bg 16-bit 5-6-5 Color to draw background with
+   @brief     Draw a closed polygon outline, as drawPolyline() plus a line
+              from the last vertex back to the first
+    @param    points  Vertices in order
+    @param    n       Number of vertices
+    @param    color   16-bit 5-6-5 Color to draw with
 */
 /**************************************************************************/
-void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
-                              int16_t w, int16_t h, uint16_t color,
-                              uint16_t bg) {
-
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t b = 0;
-
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        b <<= 1;
-      else
-        b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
-      writePixel(x + i, y, (b & 0x80) ? color : bg);
-    }
+void Adafruit_GFX::drawPolygon(const GFXpoint *points, uint16_t n,
+                               uint16_t color) {
+  if (n < 3) {
+    drawPolyline(points, n, color);
+    return;
   }
+  GFXrect run = {0, 0, 0, 0};
+  startWrite();
+  for (uint16_t i = 0; i + 1 < n; i++)
+    polyLine(points[i].x, points[i].y, points[i + 1].x, points[i + 1].y,
+             i > 0, false, &run, color);
+  polyLine(points[n - 1].x, points[n - 1].y, points[0].x, points[0].y, true,
+           true, &run, color);
+  polyRun(&run, 0, 0, 0, 0, color);
   endWrite();
 }
 
 /**************************************************************************/
 /*!
-   @brief      Draw a RAM-resident 1-bit image at the specified (x,y) position,
-   using the specified foreground color (unset bits are transparent).
-    @param    x   Top left corner x coordinate
-    @param    y   Top left corner y coordinate
-    @param    bitmap  byte array with monochrome bitmap
-    @param    w   Width of bitmap in pixels
-    @param    h   Height of bitmap in pixels
-    @param    color 16-bit 5-6-5 Color to draw with
+   @brief     Rasterize one line segment, for writeLine() and the polyline
+              functions. Bresenham's pixels, found a run at a time: the
+              pixels of a shallow line that share a row (a steep line's
+              that share a column) take one division and go to polyRun()
+              as a single run. Runs are handed over in order from (x0, y0)
+              to (x1, y1), so the first can join the previous segment's
+              last run.
+    @param    x0     Start point x coordinate
+    @param    y0     Start point y coordinate
+    @param    x1     End point x coordinate
+    @param    y1     End point y coordinate
+    @param    skip0  true to leave out the start point, already drawn
+    @param    skip1  true to leave out the end point
+    @param    run    Run still to be written, see polyRun()
+    @param    color  16-bit 5-6-5 Color to draw with
 */
 /**************************************************************************/
-void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
-                              int16_t h, uint16_t color) {
-
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t b = 0;
+void Adafruit_GFX::polyLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                            bool skip0, bool skip1, GFXrect *run,
+                            uint16_t color) {
+#if defined(ESP8266)
+  yield();
+#endif
+  if (clipReject((x0 < x1) ? x0 : x1, (y0 < y1) ? y0 : y1, abs(x1 - x0) + 1,
+                 abs(y1 - y0) + 1))
+    return;
+  int16_t steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) {
+    _swap_int16_t(x0, y0);
+    _swap_int16_t(x1, y1);
+  }
+  // The pixels are those of Bresenham's loop run from the left end, as in
+  // the classic writeLine(); a segment drawn right to left just takes its
+  // runs in the opposite order
+  bool back = x0 > x1;
+  if (back) {
+    _swap_int16_t(x0, x1);
+    _swap_int16_t(y0, y1);
+    bool t = skip0;
+    skip0 = skip1;
+    skip1 = t;
+  }
 
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        b <<= 1;
+  int32_t dx = x1 - x0, dy = abs(y1 - y0);
+  int16_t ystep = (y0 < y1) ? 1 : -1;
+  int16_t lo = x0 + skip0, hi = x1 - skip1; // Pixels wanted, major axis
+  // The classic loop starts err at dx / 2, subtracts dy per pixel and
+  // steps y when err goes negative, so row k (k > 0) begins at pixel
+  // ((k - 1) * dx + dx / 2 + 1) / dy, rounded up
+  int32_t k = back ? dy : 0;
+  int32_t a = (k && dy) ? ((k - 1) * dx + dx / 2 + dy) / dy : 0;
+  int32_t b = (k < dy) ? (k * dx + dx / 2 + dy) / dy - 1 : dx;
+  for (;;) {
+    int16_t ra = (x0 + a > lo) ? x0 + a : lo;
+    int16_t rb = (x0 + b < hi) ? x0 + b : hi;
+    int16_t y = y0 + k * ystep;
+    if (ra <= rb) {
+      if (steep)
+        polyRun(run, y, ra, 1, rb - ra + 1, color);
       else
-        b = bitmap[j * byteWidth + i / 8];
-      if (b & 0x80)
-        writePixel(x + i, y, color);
+        polyRun(run, ra, y, rb - ra + 1, 1, color);
+    }
+    if (back) {
+      if (!k--)
+        break;
+      b = a - 1;
+      a = k ? ((k - 1) * dx + dx / 2 + dy) / dy : 0;
+    } else {
+      if (++k > dy)
+        break;
+      a = b + 1;
+      b = (k < dy) ? (k * dx + dx / 2 + dy) / dy - 1 : dx;
     }
   }
-  endWrite();
 }
 
 /**************************************************************************/
 /*!
-   @brief      Draw a RAM-resident 1-bit image at the specified (x,y) position,
-   using the specified foreground (for set bits) and background (unset bits)
-   colors.
-    @param    x   Top left corner x coordinate
-    @param    y   Top left corner y coordinate
-    @param    bitmap  byte array with monochrome bitmap
-    @param    w   Width of bitmap in pixels
-    @param    h   Height of bitmap in pixels
-    @param    color 16-bit 5-6-5 Color to draw pixels with
-    @param    bg 16-bit 5-6-5 Color to draw background with
+   @brief     Queue a horizontal or vertical run of a polyline. A run that
+              touches or overlaps the pending one in the same row (or
+              column) is merged into it; otherwise the pending run is
+              written and this one takes its place.
+    @param    run    Pending run; w 0 if none
+    @param    x      Left edge
+    @param    y      Top edge
+    @param    w      Width, 1 for a vertical run; 0 just writes the pending
+                     run out
+    @param    h      Height, 1 for a horizontal run
+    @param    color  16-bit 5-6-5 Color to draw with
 */
 /**************************************************************************/
-void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
-                              int16_t h, uint16_t color, uint16_t bg) {
+void Adafruit_GFX::polyRun(GFXrect *run, int16_t x, int16_t y, int16_t w,
+                           int16_t h, uint16_t color) {
+  if (w && run->w) {
+    if ((h == 1) && (run->h == 1) && (y == run->y) &&
+        (x <= run->x + run->w) && (x + w >= run->x)) {
+      int16_t x1 = (x + w > run->x + run->w) ? x + w : run->x + run->w;
+      if (x < run->x)
+        run->x = x;
+      run->w = x1 - run->x;
+      return;
+    }
+    if ((w == 1) && (run->w == 1) && (x == run->x) &&
+        (y <= run->y + run->h) && (y + h >= run->y)) {
+      int16_t y1 = (y + h > run->y + run->h) ? y + h : run->y + run->h;
+      if (y < run->y)
+        run->y = y;
+      run->h = y1 - run->y;
+      return;
+    }
+  }
+  if (run->w) {
+    if ((run->w == 1) && (run->h == 1))
+      writePixel(run->x, run->y, color);
+    else if (run->h == 1)
+      writeFastHLine(run->x, run->y, run->w, color);
+    else
+      writeFastVLine(run->x, run->y, run->h, color);
+  }
+  run->x = x;
+  run->y = y;
+  run->w = w;
+  run->h = h;
+}
 
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t b = 0;
+// POLYGONS, THICK LINES AND ARCS ------------------------------------------
+
+/// One edge of fillPolygon()'s active edge table. x on the current
+/// scanline is kept exactly, as an integer part plus a remainder in 1/dy
+/// steps, so long edges don't drift.
+typedef struct {
+  int32_t x;    ///< x on the current scanline, rounded down
+  int32_t step; ///< dx per scanline, rounded down; added to x each line
+  uint16_t rem; ///< Fraction dropped from x, in 1/dy units
+  uint16_t inc; ///< Remainder of the step; added to rem each scanline
+  uint16_t dy;  ///< Height spanned
+  int16_t y0;   ///< Top end
+  int16_t y1;   ///< Bottom end (not part of the edge)
+  int8_t dir;   ///< 1 if the outline runs down here, -1 if up
+} GFXpolyEdge;
+
+// First column at or right of an edge on the current scanline
+static inline int32_t polyEdgeX(const GFXpolyEdge *e) {
+  return e->x + (e->rem > 0);
+}
 
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        b <<= 1;
-      else
-        b = bitmap[j * byteWidth + i / 8];
-      writePixel(x + i, y, (b & 0x80) ? color : bg);
+// v / 2^shift, rounded up
+static inline int32_t ceilShift(int32_t v, uint8_t shift) {
+  return (v >= 0) ? ((v + (1L << shift) - 1) >> shift) : -((-v) >> shift);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Integer square root, for distance work without floating point
+   @param    v  Value
+   @returns  The square root of v, rounded down
+*/
+/**************************************************************************/
+uint32_t GFXisqrt(uint32_t v) {
+  uint32_t r = 0, bit = 1UL << 30;
+  while (bit > v)
+    bit >>= 2;
+  for (; bit; bit >>= 2) {
+    if (v >= r + bit) {
+      v -= r + bit;
+      r = (r >> 1) + bit;
+    } else {
+      r >>= 1;
     }
   }
-  endWrite();
+  return r;
+}
+
+// Advance an edge n units of height (n < dy)
+static void polyEdgeJump(GFXpolyEdge *e, uint16_t n) {
+  uint32_t r = (uint32_t)n * e->inc + e->rem; // < dy * dy, fits
+  e->x += (int32_t)n * e->step + (int32_t)(r / e->dy);
+  e->rem = r % e->dy;
 }
 
 /**************************************************************************/
 /*!
-   @brief      Draw PROGMEM-resident XBitMap Files (*.xbm), exported from GIMP.
-   Usage: Export from GIMP to *.xbm, rename *.xbm to *.c and open in editor.
-   C Array can be directly used with this function.
-   There is no RAM-resident version of this function; if generating bitmaps
-   in RAM, use the format defined by drawBitmap() and call that instead.
-    @param    x   Top left corner x coordinate
-    @param    y   Top left corner y coordinate
-    @param    bitmap  byte array with monochrome bitmap
-    @param    w   Width of bitmap in pixels
-    @param    h   Height of bitmap in pixels
-    @param    color 16-bit 5-6-5 Color to draw pixels with
+   @brief     Fill a polygon, any shape, one horizontal span per crossing
+              pair on each scanline (a scanline edge-table fill)
+    @param    points  Vertices in order; the last joins back to the first
+    @param    n       Number of vertices. Outlines with more than
+                      GFX_POLY_EDGES non-horizontal edges are not drawn.
+    @param    color   16-bit 5-6-5 Color to fill with
+    @param    rule    GFX_EVEN_ODD (default) or GFX_NON_ZERO, for outlines
+                      that cross themselves or contain holes
+    @note     A pixel is filled if its center (the vertex grid) is inside.
+              Centers exactly on an edge count only for left and top
+              edges, so polygons sharing an edge never overdraw each other
+              and the rectangle (x,y) (x+w,y) (x+w,y+h) (x,y+h) fills the
+              same pixels as fillRect(x, y, w, h).
 */
 /**************************************************************************/
-void Adafruit_GFX::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
-                               int16_t w, int16_t h, uint16_t color) {
+void Adafruit_GFX::fillPolygon(const GFXpoint *points, uint16_t n,
+                               uint16_t color, GFXfillRule rule) {
+  fillPolygonFixed(points, n, 0, color, rule);
+}
 
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t b = 0;
+/**************************************************************************/
+/*!
+   @brief     fillPolygon() with vertices in fractions of a pixel, for
+              shapes built from rotated or scaled geometry
+    @param    points  Vertices in 1/2^shift pixel units, so coordinates
+                      are limited to +/-32767/2^shift pixels
+    @param    n       Number of vertices
+    @param    shift   Fraction bits in each coordinate, 0-8
+    @param    color   16-bit 5-6-5 Color to fill with
+    @param    rule    GFX_EVEN_ODD or GFX_NON_ZERO
+*/
+/**************************************************************************/
+void Adafruit_GFX::fillPolygonFixed(const GFXpoint *points, uint16_t n,
+                                    uint8_t shift, uint16_t color,
+                                    GFXfillRule rule) {
+  GFXpolyEdge edges[GFX_POLY_EDGES];
+  uint8_t active[GFX_POLY_EDGES]; // Indices into edges[], sorted by x
+  uint16_t numEdges = 0, numActive = 0, next = 0, i;
+  int16_t xa = 0x7FFF, xb = -0x8000, yb = -0x8000;
+  uint16_t unit = 1 << shift; // Scanline spacing, in coordinate units
+
+  // Edge table, sorted by top end. Horizontal edges add nothing.
+  for (i = 0; i < n; i++) {
+    GFXpoint p0 = points[i], p1 = points[(i + 1 < n) ? i + 1 : 0];
+    if (p0.x < xa)
+      xa = p0.x;
+    if (p0.x > xb)
+      xb = p0.x;
+    if (p0.y == p1.y)
+      continue;
+    if (numEdges >= GFX_POLY_EDGES)
+      return;
+    GFXpolyEdge e;
+    e.dir = 1;
+    if (p0.y > p1.y) {
+      GFXpoint t = p0;
+      p0 = p1;
+      p1 = t;
+      e.dir = -1;
+    }
+    int32_t dx = (int32_t)p1.x - p0.x;
+    e.dy = (int32_t)p1.y - p0.y;
+    e.step = dx / e.dy; // Per unit of height, for now
+    if (e.step * e.dy > dx) // Round down, not toward zero
+      e.step--;
+    e.inc = dx - e.step * e.dy;
+    e.x = p0.x;
+    e.rem = 0;
+    e.y0 = p0.y;
+    e.y1 = p1.y;
+    if (p1.y > yb)
+      yb = p1.y;
+    uint16_t j = numEdges++;
+    for (; (j > 0) && (edges[j - 1].y0 > e.y0); j--)
+      edges[j] = edges[j - 1];
+    edges[j] = e;
+  }
+  if (!numEdges)
+    return;
+
+  // Only the scanlines and columns inside the clip rectangle are visited
+  GFXrect clip = getClipRect();
+  int32_t cx0 = clip.x, cx1 = (int32_t)clip.x + clip.w;
+  int32_t y = ceilShift(edges[0].y0, shift);
+  int32_t y1 = ceilShift(yb, shift);
+  if (y < clip.y)
+    y = clip.y;
+  if (y1 > (int32_t)clip.y + clip.h)
+    y1 = (int32_t)clip.y + clip.h;
+  if ((ceilShift(xb, shift) <= cx0) || (ceilShift(xa, shift) >= cx1))
+    return;
 
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        b >>= 1;
-      else
-        b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
-      // Nearly identical to drawBitmap(), only the bit order
-      // is reversed here (left-to-right = LSB to MSB):
-      if (b & 0x01)
-        writePixel(x + i, y, color);
+  for (; y < y1; y++) {
+    int32_t ys = y * unit; // Scanline, in coordinate units
+    // Retire edges that ended above this scanline...
+    uint16_t k = 0;
+    for (i = 0; i < numActive; i++) {
+      if (edges[active[i]].y1 > ys)
+        active[k++] = active[i];
+    }
+    numActive = k;
+    // ...and activate the ones starting here, or above the clip rectangle
+    for (; (next < numEdges) && (edges[next].y0 <= ys); next++) {
+      GFXpolyEdge *e = &edges[next];
+      if (e->y1 <= ys)
+        continue;
+      polyEdgeJump(e, ys - e->y0); // Straight to this scanline
+      if (shift) { // From here on, step a whole scanline at a time
+        uint32_t r = (uint32_t)e->inc * unit;
+        e->step = e->step * unit + (int32_t)(r / e->dy);
+        e->inc = r % e->dy;
+      }
+      active[numActive++] = next;
+    }
+    if (!numActive) {
+      if (next >= numEdges)
+        break;
+      continue;
+    }
+
+    // Keep the active list sorted by x; it barely changes line to line
+    for (i = 1; i < numActive; i++) {
+      uint8_t a = active[i];
+      int32_t x = polyEdgeX(&edges[a]);
+      for (k = i; (k > 0) && (polyEdgeX(&edges[active[k - 1]]) > x); k--)
+        active[k] = active[k - 1];
+      active[k] = a;
+    }
+
+    // One span from each edge that enters the shape to the one that leaves
+    int16_t winding = 0;
+    int32_t start = 0;
+    for (i = 0; i < numActive; i++) {
+      GFXpolyEdge *e = &edges[active[i]];
+      bool wasIn = (rule == GFX_NON_ZERO) ? (winding != 0) : (winding & 1);
+      winding += (rule == GFX_NON_ZERO) ? e->dir : 1;
+      bool isIn = (rule == GFX_NON_ZERO) ? (winding != 0) : (winding & 1);
+      if (!wasIn && isIn) {
+        start = ceilShift(polyEdgeX(e), shift);
+      } else if (wasIn && !isIn) {
+        int32_t x0 = (start > cx0) ? start : cx0;
+        int32_t x1 = ceilShift(polyEdgeX(e), shift);
+        if (x1 > cx1)
+          x1 = cx1;
+        if (x0 < x1)
+          writeFastHLine(x0, y, x1 - x0, color);
+      }
+      polyEdgeJump(e, 1); // Step to the next scanline
     }
   }
   endWrite();
@@ -872,46 +1266,293 @@ void Adafruit_GFX::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
 
 /**************************************************************************/
 /*!
-   @brief   Draw a PROGMEM-resident 8-bit image (grayscale) at the specified
-   (x,y) pos. Specifically for 8-bit display devices such as IS31FL3731; no
-   color reduction/expansion is performed.
-    @param    x   Top left corner x coordinate
-    @param    y   Top left corner y coordinate
-    @param    bitmap  byte array with grayscale bitmap
-    @param    w   Width of bitmap in pixels
-    @param    h   Height of bitmap in pixels
+   @brief     Draw a line of any width, as one filled quadrilateral
+    @param    x0     Start point x coordinate
+    @param    y0     Start point y coordinate
+    @param    x1     End point x coordinate
+    @param    y1     End point y coordinate
+    @param    width  Thickness in pixels, across the line; 1 or less draws
+                     an ordinary line
+    @param    color  16-bit 5-6-5 Color to draw with
+    @note     The ends are square and reach half a pixel past each end
+              point, so a horizontal or vertical line covers the same
+              pixels as the matching fillRect(). Corners are placed to
+              1/16 pixel; coordinates beyond about +/-2000 get coarser.
 */
 /**************************************************************************/
-void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
-                                       const uint8_t bitmap[], int16_t w,
-                                       int16_t h) {
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      writePixel(x + i, y, (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
+void Adafruit_GFX::drawThickLine(int16_t x0, int16_t y0, int16_t x1,
+                                 int16_t y1, int16_t width, uint16_t color) {
+  if (width <= 1) {
+    drawLine(x0, y0, x1, y1, color);
+    return;
+  }
+  int32_t dx = (int32_t)x1 - x0, dy = (int32_t)y1 - y0;
+  if (!dx && !dy) {
+    fillRect(x0 - width / 2, y0 - width / 2, width, width, color);
+    return;
+  }
+
+  // Fraction bits that keep every corner within int16_t
+  int32_t m = abs(x0);
+  if (abs(x1) > m)
+    m = abs(x1);
+  if (abs(y0) > m)
+    m = abs(y0);
+  if (abs(y1) > m)
+    m = abs(y1);
+  m += width + 1;
+  uint8_t shift = 4;
+  while (shift && ((m << shift) > 0x7FFF))
+    shift--;
+  if (m > 0x7FFF)
+    return;
+  int32_t unit = 1 << shift;
+
+  // Unit direction in 1/16384ths. k extra bits of length precision are
+  // taken while dx << (14 + k) still fits, so short lines stay accurate.
+  int32_t ex = dx, ey = dy;
+  while ((abs(ex) > 0x7FFF) || (abs(ey) > 0x7FFF)) {
+    ex /= 2;
+    ey /= 2;
+  }
+  uint32_t d2 = (uint32_t)(ex * ex) + (uint32_t)(ey * ey);
+  uint8_t k = 0;
+  while ((k < 8) && (d2 < (1UL << (30 - 2 * k))))
+    k++;
+  int32_t len = GFXisqrt(d2 << (2 * k));
+  int32_t ux = ex * (1L << (14 + k)) / len;
+  int32_t uy = ey * (1L << (14 + k)) / len;
+
+  // Half the width across, and the half-pixel end caps along, the line
+  int32_t nx = -uy * (width * unit) / 32768, ny = ux * (width * unit) / 32768;
+  int32_t cx = ux * unit / 32768, cy = uy * unit / 32768;
+  int32_t ax = x0 * unit - cx, ay = y0 * unit - cy;
+  int32_t bx = x1 * unit + cx, by = y1 * unit + cy;
+  GFXpoint corners[4] = {{(int16_t)(ax + nx), (int16_t)(ay + ny)},
+                         {(int16_t)(bx + nx), (int16_t)(by + ny)},
+                         {(int16_t)(bx - nx), (int16_t)(by - ny)},
+                         {(int16_t)(ax - nx), (int16_t)(ay - ny)}};
+  fillPolygonFixed(corners, 4, shift, color, GFX_EVEN_ODD);
+}
+
+// sin() in 1/16384ths, per whole degree from 0 to 90
+static const uint16_t sinTable[91] PROGMEM = {
+    0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563,
+    2845, 3126, 3406, 3686, 3964, 4240, 4516, 4790, 5063, 5334,
+    5604, 5872, 6138, 6402, 6664, 6924, 7182, 7438, 7692, 7943,
+    8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384};
+
+// sin() of any whole number of degrees, in 1/16384ths
+static int16_t sinDeg(int32_t deg) {
+  deg %= 360;
+  if (deg < 0)
+    deg += 360;
+  if (deg <= 90)
+    return pgm_read_word(&sinTable[deg]);
+  if (deg <= 180)
+    return pgm_read_word(&sinTable[180 - deg]);
+  if (deg <= 270)
+    return -(int16_t)pgm_read_word(&sinTable[deg - 180]);
+  return -(int16_t)pgm_read_word(&sinTable[360 - deg]);
+}
+
+// a / b rounded down, and rounded up
+static int32_t floorDiv(int32_t a, int32_t b) {
+  int32_t q = a / b;
+  return ((a % b) && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+static int32_t ceilDiv(int32_t a, int32_t b) {
+  int32_t q = a / b;
+  return ((a % b) && ((a < 0) == (b < 0))) ? q + 1 : q;
+}
+
+#define ARC_FAR 0x10000L ///< Past any column an arc can reach
+
+// Columns px of row py (relative to the center) whose angle is in the
+// half-turn [a, a+180), given sin and cos of a, as [*lo, *hi]. Points on
+// the ray at a are in; those on the opposite ray are not.
+static void arcHalfTurn(int32_t s, int32_t c, int32_t py, int32_t *lo,
+                        int32_t *hi) {
+  // Clockwise of the ray: s*py + c*px > 0
+  int32_t q = -s * py;
+  *lo = -ARC_FAR;
+  *hi = ARC_FAR;
+  if (!c) { // Ray points left or right
+    if (!py) {
+      if (s > 0)
+        *lo = 1;
+      else
+        *hi = -1;
+    } else if (s * py < 0) {
+      *lo = 1; // Empty
+      *hi = 0;
     }
+    return;
   }
-  endWrite();
+  int32_t x = (c > 0) ? floorDiv(q, c) + 1 : ceilDiv(q, c) - 1;
+  if (!(q % c)) { // A pixel center on the line: in if on the ray
+    int32_t x0 = q / c;
+    if ((x0 > -ARC_FAR) && (x0 < ARC_FAR) && (s * x0 - c * py > 0))
+      x = x0;
+  }
+  if (x < -ARC_FAR)
+    x = -ARC_FAR;
+  else if (x > ARC_FAR)
+    x = ARC_FAR;
+  if (c > 0)
+    *lo = x;
+  else
+    *hi = x;
 }
 
 /**************************************************************************/
 /*!
-   @brief   Draw a RAM-resident 8-bit image (grayscale) at the specified (x,y)
-   pos. Specifically for 8-bit display devices such as IS31FL3731; no color
-   reduction/expansion is performed.
-    @param    x   Top left corner x coordinate
-    @param    y   Top left corner y coordinate
-    @param    bitmap  byte array with grayscale bitmap
-    @param    w   Width of bitmap in pixels
-    @param    h   Height of bitmap in pixels
+   @brief     Fill part of a ring, e.g. a gauge or progress indicator,
+              one horizontal span per row and piece
+    @param    x0     Center-point x coordinate
+    @param    y0     Center-point y coordinate
+    @param    r0     Inner radius; 0 for a pie slice
+    @param    r1     Outer radius
+    @param    a0     Start angle in degrees, clockwise from 12 o'clock
+    @param    a1     End angle in degrees, greater than a0; a1 - a0 of 360
+                     or more fills the whole ring
+    @param    color  16-bit 5-6-5 Color to fill with
+    @note     A pixel is in if its center's angle is in [a0, a1) and its
+              distance, rounded, is in r0..r1; the center pixel counts as
+              0 degrees. Arcs that share an angle or a radius meet with no
+              gap or overlap, so a gauge moving from angle a to b needs
+              only fillArc(x0, y0, r0, r1, a, b) in the new color (or b to
+              a in the background color).
 */
 /**************************************************************************/
-void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
-                                       int16_t w, int16_t h) {
+void Adafruit_GFX::fillArc(int16_t x0, int16_t y0, int16_t r0, int16_t r1,
+                           int16_t a0, int16_t a1, uint16_t color) {
+  int32_t sweep = (int32_t)a1 - a0;
+  if ((r1 < 0) || (r1 < r0) || (sweep <= 0) ||
+      clipReject(x0 - r1, y0 - r1, 2 * r1 + 1, 2 * r1 + 1))
+    return;
+  int32_t s0 = sinDeg(a0), c0 = sinDeg((int32_t)a0 + 90);
+  int32_t s1 = sinDeg(a1), c1 = sinDeg((int32_t)a1 + 90);
+  GFXrect clip = getClipRect();
+
+  // Half widths of the disc and of the hole, walked down from the middle
+  int32_t outer = (int32_t)r1 * r1 + r1; // (r1 + 1/2)^2, rounded down
+  int32_t inner = (r0 > 0) ? (int32_t)r0 * r0 - r0 : -1;
+  int32_t xo = r1, xi = r0 - 1;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      writePixel(x + i, y, bitmap[j * w + i]);
+  for (int32_t dy = 0; dy <= r1; dy++) {
+    while (xo * xo + dy * dy > outer)
+      xo--;
+    while ((xi >= 0) && (xi * xi + dy * dy > inner))
+      xi--;
+    for (int32_t py = -dy; py <= dy; py += (dy ? 2 * dy : 1)) {
+      int32_t y = y0 + py;
+      if ((y < clip.y) || (y >= (int32_t)clip.y + clip.h))
+        continue;
+      // Columns inside the sweep: up to three runs
+      int32_t sec[3][2], ann[2][2];
+      uint8_t ns = 1, na = 1;
+      if (sweep >= 360) {
+        sec[0][0] = -ARC_FAR;
+        sec[0][1] = ARC_FAR;
+      } else {
+        int32_t lo, hi; // Before a1: not in [a1, a1+180)
+        arcHalfTurn(s0, c0, py, &sec[0][0], &sec[0][1]);
+        arcHalfTurn(s1, c1, py, &lo, &hi);
+        if (lo > hi) {
+          lo = -ARC_FAR;
+          hi = ARC_FAR;
+        } else if ((lo == -ARC_FAR) && (hi == ARC_FAR)) {
+          lo = 1;
+          hi = 0;
+        } else if (lo == -ARC_FAR) {
+          lo = hi + 1;
+          hi = ARC_FAR;
+        } else {
+          hi = lo - 1;
+          lo = -ARC_FAR;
+        }
+        if (sweep <= 180) { // Both
+          if (lo > sec[0][0])
+            sec[0][0] = lo;
+          if (hi < sec[0][1])
+            sec[0][1] = hi;
+        } else if (sec[0][0] > sec[0][1]) { // Either
+          sec[0][0] = lo;
+          sec[0][1] = hi;
+        } else if ((lo <= hi) && ((hi < sec[0][0] - 1) ||
+                                  (lo > sec[0][1] + 1))) {
+          sec[1][0] = lo;
+          sec[1][1] = hi;
+          ns = 2;
+        } else if (lo <= hi) { // Overlapping, join them
+          if (lo < sec[0][0])
+            sec[0][0] = lo;
+          if (hi > sec[0][1])
+            sec[0][1] = hi;
+        }
+      }
+      if (!py && (r0 <= 0) && (sweep < 360)) {
+        // The center has no angle; count it at 0 degrees, so it's in the
+        // one arc of a split that covers 12 o'clock
+        int32_t m = a0 % 360;
+        if (m < 0)
+          m += 360;
+        bool mid = (m ? 360 - m : 0) < sweep;
+        uint8_t i = 0;
+        while ((i < ns) && ((sec[i][0] > 0) || (sec[i][1] < 0)))
+          i++;
+        if (mid && (i == ns)) { // Add it, joining any run beside it
+          uint8_t l = ns, r = ns;
+          for (i = 0; i < ns; i++) {
+            if (sec[i][1] == -1)
+              l = i;
+            else if (sec[i][0] == 1)
+              r = i;
+          }
+          if ((l < ns) && (r < ns)) {
+            sec[l][1] = sec[r][1];
+            sec[r][0] = sec[--ns][0];
+            sec[r][1] = sec[ns][1];
+          } else if (l < ns) {
+            sec[l][1] = 0;
+          } else if (r < ns) {
+            sec[r][0] = 0;
+          } else {
+            sec[ns][0] = sec[ns][1] = 0;
+            ns++;
+          }
+        } else if (!mid && (i < ns)) { // Take it out
+          sec[ns][0] = 1;
+          sec[ns][1] = sec[i][1];
+          sec[i][1] = -1;
+          ns++;
+        }
+      }
+      // Columns inside the ring: one run, or two either side of the hole
+      ann[0][0] = -xo;
+      ann[0][1] = xo;
+      if (xi >= 0) {
+        ann[0][1] = -xi - 1;
+        ann[1][0] = xi + 1;
+        ann[1][1] = xo;
+        na = 2;
+      }
+      for (uint8_t i = 0; i < ns; i++) {
+        for (uint8_t j = 0; j < na; j++) {
+          int32_t lo = (sec[i][0] > ann[j][0]) ? sec[i][0] : ann[j][0];
+          int32_t hi = (sec[i][1] < ann[j][1]) ? sec[i][1] : ann[j][1];
+          if (lo <= hi)
+            writeFastHLine(x0 + lo, y, hi - lo + 1, color);
+        }
+      }
     }
   }
   endWrite();
@@ -919,146 +1560,313 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
 
 /**************************************************************************/
 /*!
-   @brief   Draw a PROGMEM-resident 8-bit image (grayscale) with a 1-bit mask
-   (set bits = opaque, unset bits = clear) at the specified (x,y) position.
-   BOTH buffers (grayscale and mask) must be PROGMEM-resident.
-   Specifically for 8-bit display devices such as IS31FL3731; no color
-   reduction/expansion is performed.
-    @param    x   Top left corner x coordinate
-    @param    y   Top left corner y coordinate
-    @param    bitmap  byte array with grayscale bitmap
-    @param    mask  byte array with mask bitmap
-    @param    w   Width of bitmap in pixels
-    @param    h   Height of bitmap in pixels
+   @brief     Fill a whole ring (annulus)
+    @param    x0     Center-point x coordinate
+    @param    y0     Center-point y coordinate
+    @param    r0     Inner radius; 0 for a solid disc
+    @param    r1     Outer radius
+    @param    color  16-bit 5-6-5 Color to fill with
 */
 /**************************************************************************/
-void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
-                                       const uint8_t bitmap[],
-                                       const uint8_t mask[], int16_t w,
-                                       int16_t h) {
-  int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
-  uint8_t b = 0;
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        b <<= 1;
-      else
-        b = pgm_read_byte(&mask[j * bw + i / 8]);
-      if (b & 0x80) {
-        writePixel(x + i, y, (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
+void Adafruit_GFX::drawRing(int16_t x0, int16_t y0, int16_t r0, int16_t r1,
+                            uint16_t color) {
+  fillArc(x0, y0, r0, r1, 0, 360, color);
+}
+
+// CURVES ------------------------------------------------------------------
+
+#define CURVE_ONE ((int32_t)1024) ///< One pixel in curve flattening units
+
+/**************************************************************************/
+/*!
+   @brief     Flatten a cubic Bezier curve by halving it until each piece
+              is within a tolerance of its chord. A piece strays from its
+              chord by at most 3/4 of its largest second difference, so
+              the test needs no square roots.
+    @param    curve  x0, y0 .. x3, y3, in CURVE_ONE units
+    @param    tol    Allowed distance from the chord, CURVE_ONE units
+    @param    shift  Fraction bits wanted in the output points
+    @param    out    Receives the end of each piece, not the curve's start
+    @param    max    Room in out[]
+    @returns  Number of points written, 0 if they didn't fit
+*/
+/**************************************************************************/
+static uint16_t bezierFlatten(const int32_t *curve, int32_t tol, uint8_t shift,
+                              GFXpoint *out, uint16_t max) {
+  int32_t stack[GFX_CURVE_DEPTH][8]; // Second halves still to flatten
+  uint8_t level[GFX_CURVE_DEPTH];    // How often each was halved
+  int32_t c[8];
+  int32_t unit = CURVE_ONE >> shift;
+  uint8_t sp = 0, depth = 0, i;
+  uint16_t n = 0;
+  for (i = 0; i < 8; i++)
+    c[i] = curve[i];
+  for (;;) {
+    int32_t e = 0; // Largest second difference
+    for (i = 0; i < 4; i++) {
+      int32_t d = c[i] - 2 * c[i + 2] + c[i + 4];
+      if (d < 0)
+        d = -d;
+      if (d > e)
+        e = d;
+    }
+    if ((depth < GFX_CURVE_DEPTH) && (3 * e > 4 * tol)) {
+      int32_t *r = stack[sp]; // Split at t = 1/2 (de Casteljau)
+      level[sp++] = ++depth;
+      for (i = 0; i < 2; i++) {
+        int32_t p01 = (c[i] + c[i + 2]) / 2, p12 = (c[i + 2] + c[i + 4]) / 2;
+        int32_t p23 = (c[i + 4] + c[i + 6]) / 2;
+        int32_t p012 = (p01 + p12) / 2, p123 = (p12 + p23) / 2;
+        int32_t mid = (p012 + p123) / 2;
+        r[i] = mid;
+        r[i + 2] = p123;
+        r[i + 4] = p23;
+        r[i + 6] = c[i + 6];
+        c[i + 2] = p01;
+        c[i + 4] = p012;
+        c[i + 6] = mid;
       }
+      continue;
     }
+    if (n >= max)
+      return 0;
+    out[n].x = floorDiv(c[6] + unit / 2, unit);
+    out[n++].y = floorDiv(c[7] + unit / 2, unit);
+    if (!sp)
+      return n;
+    sp--;
+    for (i = 0; i < 8; i++)
+      c[i] = stack[sp][i];
+    depth = level[sp];
   }
-  endWrite();
 }
 
 /**************************************************************************/
 /*!
-   @brief   Draw a RAM-resident 8-bit image (grayscale) with a 1-bit mask
-   (set bits = opaque, unset bits = clear) at the specified (x,y) position.
-   BOTH buffers (grayscale and mask) must be RAM-residentt, no mix-and-match
-   Specifically for 8-bit display devices such as IS31FL3731; no color
-   reduction/expansion is performed.
-    @param    x   Top left corner x coordinate
-    @param    y   Top left corner y coordinate
-    @param    bitmap  byte array with grayscale bitmap
-    @param    mask  byte array with mask bitmap
-    @param    w   Width of bitmap in pixels
-    @param    h   Height of bitmap in pixels
+   @brief     Flatten a closed path into polygon vertices
+    @param    points  Path, see fillPath()
+    @param    n       Number of points
+    @param    tol     Allowed distance from the curves, CURVE_ONE units
+    @param    out     Receives vertices in 1/16 pixel units
+    @param    max     Room in out[]
+    @returns  Number of vertices, 0 if they didn't fit, -1 if the path has
+              no on-curve point
 */
 /**************************************************************************/
-void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
-                                       uint8_t *mask, int16_t w, int16_t h) {
-  int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
-  uint8_t b = 0;
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        b <<= 1;
-      else
-        b = mask[j * bw + i / 8];
-      if (b & 0x80) {
-        writePixel(x + i, y, bitmap[j * w + i]);
+static int16_t pathFlatten(const GFXpathPoint *points, uint16_t n, int32_t tol,
+                           GFXpoint *out, uint16_t max) {
+  uint16_t s = 0, m = 0;
+  while ((s < n) && points[s].control)
+    s++;
+  if (s >= n)
+    return -1;
+  int32_t c[8]; // Segment start, then control points as they come
+  uint8_t k = 0;
+  c[0] = points[s].x * CURVE_ONE;
+  c[1] = points[s].y * CURVE_ONE;
+  for (uint16_t i = 1; i <= n; i++) { // Back round to the start
+    const GFXpathPoint *p = &points[(s + i) % n];
+    int32_t x = p->x * CURVE_ONE, y = p->y * CURVE_ONE;
+    if (p->control && (k < 2)) {
+      c[2 + 2 * k] = x;
+      c[3 + 2 * k] = y;
+      k++;
+      continue;
+    }
+    if (!k) { // Straight edge
+      if (m >= max)
+        return 0;
+      out[m].x = p->x * 16;
+      out[m++].y = p->y * 16;
+    } else {
+      if (k == 1) { // Quadratic, as the same curve in cubic form
+        c[4] = x + (c[2] - x) * 2 / 3;
+        c[5] = y + (c[3] - y) * 2 / 3;
+        c[2] = c[0] + (c[2] - c[0]) * 2 / 3;
+        c[3] = c[1] + (c[3] - c[1]) * 2 / 3;
       }
+      c[6] = x;
+      c[7] = y;
+      uint16_t got = bezierFlatten(c, tol, 4, out + m, max - m);
+      if (!got)
+        return 0;
+      m += got;
     }
+    c[0] = x;
+    c[1] = y;
+    k = 0;
   }
-  endWrite();
+  return m;
 }
 
 /**************************************************************************/
 /*!
-   @brief   Draw a PROGMEM-resident 16-bit image (RGB 5/6/5) at the specified
-   (x,y) position. For 16-bit display devices; no color reduction performed.
-    @param    x   Top left corner x coordinate
-    @param    y   Top left corner y coordinate
-    @param    bitmap  byte array with 16-bit color bitmap
-    @param    w   Width of bitmap in pixels
-    @param    h   Height of bitmap in pixels
+   @brief     Draw a quadratic Bezier curve, in fixed point throughout
+    @param    x0        Start point x coordinate
+    @param    y0        Start point y coordinate
+    @param    x1        Control point x coordinate
+    @param    y1        Control point y coordinate
+    @param    x2        End point x coordinate
+    @param    y2        End point y coordinate
+    @param    color     16-bit 5-6-5 Color to draw with
+    @param    flatness  How far the line segments drawn may stray from the
+                        true curve, in 1/16 pixels
 */
 /**************************************************************************/
-void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
-                                 int16_t w, int16_t h) {
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      writePixel(x + i, y, pgm_read_word(&bitmap[j * w + i]));
+void Adafruit_GFX::drawQuadBezier(int16_t x0, int16_t y0, int16_t x1,
+                                  int16_t y1, int16_t x2, int16_t y2,
+                                  uint16_t color, uint8_t flatness) {
+  // The same curve as a cubic, control points 2/3 of the way to (x1,y1)
+  int32_t c[8] = {x0 * CURVE_ONE,
+                  y0 * CURVE_ONE,
+                  x0 * CURVE_ONE + (x1 - x0) * (2 * CURVE_ONE) / 3,
+                  y0 * CURVE_ONE + (y1 - y0) * (2 * CURVE_ONE) / 3,
+                  x2 * CURVE_ONE + (x1 - x2) * (2 * CURVE_ONE) / 3,
+                  y2 * CURVE_ONE + (y1 - y2) * (2 * CURVE_ONE) / 3,
+                  x2 * CURVE_ONE,
+                  y2 * CURVE_ONE};
+  drawBezier(c, flatness, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief     Draw a cubic Bezier curve, in fixed point throughout
+    @param    x0        Start point x coordinate
+    @param    y0        Start point y coordinate
+    @param    x1        First control point x coordinate
+    @param    y1        First control point y coordinate
+    @param    x2        Second control point x coordinate
+    @param    y2        Second control point y coordinate
+    @param    x3        End point x coordinate
+    @param    y3        End point y coordinate
+    @param    color     16-bit 5-6-5 Color to draw with
+    @param    flatness  How far the line segments drawn may stray from the
+                        true curve, in 1/16 pixels
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawCubicBezier(int16_t x0, int16_t y0, int16_t x1,
+                                   int16_t y1, int16_t x2, int16_t y2,
+                                   int16_t x3, int16_t y3, uint16_t color,
+                                   uint8_t flatness) {
+  int32_t c[8] = {x0 * CURVE_ONE, y0 * CURVE_ONE, x1 * CURVE_ONE,
+                  y1 * CURVE_ONE, x2 * CURVE_ONE, y2 * CURVE_ONE,
+                  x3 * CURVE_ONE, y3 * CURVE_ONE};
+  drawBezier(c, flatness, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief     Fill a closed outline made of straight and curved segments,
+              e.g. a rounded UI shape or an icon, as fillPolygon() does
+    @param    points    Outline in order, ending back at the start. Points
+                        with control set shape the segment between the
+                        on-curve points either side: none gives a straight
+                        edge, one a quadratic curve, two a cubic. A third
+                        control point in a row is taken as on-curve.
+                        Coordinates are limited to +/-2047.
+    @param    n         Number of points
+    @param    color     16-bit 5-6-5 Color to fill with
+    @param    rule      GFX_EVEN_ODD (default) or GFX_NON_ZERO
+    @param    flatness  How far the polygon filled may stray from the true
+                        curves, in 1/16 pixels. If the curves need more
+                        than GFX_POLY_EDGES vertices, it is relaxed until
+                        they fit.
+*/
+/**************************************************************************/
+void Adafruit_GFX::fillPath(const GFXpathPoint *points, uint16_t n,
+                            uint16_t color, GFXfillRule rule,
+                            uint8_t flatness) {
+  GFXpoint verts[GFX_POLY_EDGES];
+  for (int32_t tol = flatness ? flatness * (CURVE_ONE / 16) : 1;
+       tol < (1L << 27); tol *= 2) {
+    int16_t m = pathFlatten(points, n, tol, verts, GFX_POLY_EDGES);
+    if (m < 0)
+      return;
+    if (m > 0) {
+      fillPolygonFixed(verts, m, 4, color, rule);
+      return;
     }
   }
-  endWrite();
 }
 
 /**************************************************************************/
 /*!
-   @brief   Draw a RAM-resident 16-bit image (RGB 5/6/5) at the specified (x,y)
-   position. For 16-bit display devices; no color reduction performed.
-    @param    x   Top left corner x coordinate
-    @param    y   Top left corner y coordinate
-    @param    bitmap  byte array with 16-bit color bitmap
-    @param    w   Width of bitmap in pixels
-    @param    h   Height of bitmap in pixels
+   @brief     Flatten a cubic Bezier curve and draw it as a polyline, one
+              run at a time, in a single write transaction
+    @param    c         x0, y0 .. x3, y3, in CURVE_ONE units, ends on
+                        whole pixels
+    @param    flatness  Allowed distance from the curve, 1/16 pixels
+    @param    color     16-bit 5-6-5 Color to draw with
 */
 /**************************************************************************/
-void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
-                                 int16_t w, int16_t h) {
+void Adafruit_GFX::drawBezier(const int32_t *c, uint8_t flatness,
+                              uint16_t color) {
+  int32_t x0 = c[0], y0 = c[1], x1 = c[0], y1 = c[1]; // Control point box
+  for (uint8_t i = 2; i < 8; i += 2) {
+    if (c[i] < x0)
+      x0 = c[i];
+    if (c[i] > x1)
+      x1 = c[i];
+    if (c[i + 1] < y0)
+      y0 = c[i + 1];
+    if (c[i + 1] > y1)
+      y1 = c[i + 1];
+  }
+  x0 = floorDiv(x0, CURVE_ONE);
+  y0 = floorDiv(y0, CURVE_ONE);
+  if (clipReject(x0, y0, ceilDiv(x1, CURVE_ONE) - x0 + 1,
+                 ceilDiv(y1, CURVE_ONE) - y0 + 1))
+    return; // The curve stays inside its control points' box
+
+  GFXpoint pts[1 << GFX_CURVE_DEPTH];
+  uint16_t n = bezierFlatten(c, flatness * (CURVE_ONE / 16), 0, pts,
+                             1 << GFX_CURVE_DEPTH);
+  GFXrect run = {0, 0, 0, 0};
+  int16_t x = c[0] / CURVE_ONE, y = c[1] / CURVE_ONE;
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      writePixel(x + i, y, bitmap[j * w + i]);
-    }
+  polyRun(&run, x, y, 1, 1, color);
+  for (uint16_t i = 0; i < n; i++) {
+    if ((pts[i].x == x) && (pts[i].y == y))
+      continue;
+    polyLine(x, y, pts[i].x, pts[i].y, true, false, &run, color);
+    x = pts[i].x;
+    y = pts[i].y;
   }
+  polyRun(&run, 0, 0, 0, 0, color);
   endWrite();
 }
 
+// BITMAP / XBITMAP / GRAYSCALE / RGB BITMAP FUNCTIONS ---------------------
+
 /**************************************************************************/
 /*!
-   @brief   Draw a PROGMEM-resident 16-bit image (RGB 5/6/5) with a 1-bit mask
-   (set bits = opaque, unset bits = clear) at the specified (x,y) position. BOTH
-   buffers (color and mask) must be PROGMEM-resident. For 16-bit display
-   devices; no color reduction performed.
+   @brief      Draw a PROGMEM-resident 1-bit image at the specified (x,y)
+   position, using the specified foreground color (unset bits are transparent).
     @param    x   Top left corner x coordinate
     @param    y   Top left corner y coordinate
-    @param    bitmap  byte array with 16-bit color bitmap
-    @param    mask  byte array with monochrome mask bitmap
+    @param    bitmap  byte array with monochrome bitmap
     @param    w   Width of bitmap in pixels
     @param    h   Height of bitmap in pixels
+    @param    color 16-bit 5-6-5 Color to draw with
 */
 /**************************************************************************/
-void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
-                                 const uint8_t mask[], int16_t w, int16_t h) {
-  int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                              int16_t w, int16_t h, uint16_t color) {
+  if (clipReject(x, y, w, h))
+    return;
+
+  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
   uint8_t b = 0;
+
   startWrite();
   for (int16_t j = 0; j < h; j++, y++) {
     for (int16_t i = 0; i < w; i++) {
       if (i & 7)
         b <<= 1;
       else
-        b = pgm_read_byte(&mask[j * bw + i / 8]);
-      if (b & 0x80) {
-        writePixel(x + i, y, pgm_read_word(&bitmap[j * w + i]));
-      }
+        b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+      if (b & 0x80)
+        writePixel(x + i, y, color);
     }
   }
   endWrite();
@@ -1066,138 +1874,491 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
 
 /**************************************************************************/
 /*!
-   @brief   Draw a RAM-resident 16-bit image (RGB 5/6/5) with a 1-bit mask (set
-   bits = opaque, unset bits = clear) at the specified (x,y) position. BOTH
-   buffers (color and mask) must be RAM-resident. For 16-bit display devices; no
-   color reduction performed.
+   @brief      Draw a PROGMEM-resident 1-bit image at the specified (x,y)
+   position, using the specified foreground (for set bits) and background (unset
+   bits) colors.
     @param    x   Top left corner x coordinate
     @param    y   Top left corner y coordinate
-    @param    bitmap  byte array with 16-bit color bitmap
-    @param    mask  byte array with monochrome mask bitmap
+    @param    bitmap  byte array with monochrome bitmap
     @param    w   Width of bitmap in pixels
     @param    h   Height of bitmap in pixels
+    @param    color 16-bit 5-6-5 Color to draw pixels with
+    @param    bg 16-bit 5-6-5 Color to draw background with
 */
 /**************************************************************************/
-void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
-                                 uint8_t *mask, int16_t w, int16_t h) {
-  int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                              int16_t w, int16_t h, uint16_t color,
+                              uint16_t bg) {
+  if (clipReject(x, y, w, h))
+    return;
+
+  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
   uint8_t b = 0;
+
   startWrite();
   for (int16_t j = 0; j < h; j++, y++) {
     for (int16_t i = 0; i < w; i++) {
       if (i & 7)
         b <<= 1;
       else
-        b = mask[j * bw + i / 8];
-      if (b & 0x80) {
-        writePixel(x + i, y, bitmap[j * w + i]);
-      }
+        b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+      writePixel(x + i, y, (b & 0x80) ? color : bg);
     }
   }
   endWrite();
 }
 
-// TEXT- AND CHARACTER-HANDLING FUNCTIONS ----------------------------------
-
-// Draw a character
 /**************************************************************************/
 /*!
-   @brief   Draw a single character
-    @param    x   Bottom left corner x coordinate
-    @param    y   Bottom left corner y coordinate
-    @param    c   The 8-bit font-indexed character (likely ascii)
-    @param    color 16-bit 5-6-5 Color to draw chraracter with
-    @param    bg 16-bit 5-6-5 Color to fill background with (if same as color,
-   no background)
-    @param    size  Font magnification level, 1 is 'original' size
+   @brief      Draw a RAM-resident 1-bit image at the specified (x,y) position,
+   using the specified foreground color (unset bits are transparent).
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    color 16-bit 5-6-5 Color to draw with
 */
 /**************************************************************************/
-void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
-                            uint16_t color, uint16_t bg, uint8_t size) {
-  drawChar(x, y, c, color, bg, size, size);
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                              int16_t h, uint16_t color) {
+  if (clipReject(x, y, w, h))
+    return;
+
+  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
+  uint8_t b = 0;
+
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (i & 7)
+        b <<= 1;
+      else
+        b = bitmap[j * byteWidth + i / 8];
+      if (b & 0x80)
+        writePixel(x + i, y, color);
+    }
+  }
+  endWrite();
 }
 
-// Draw a character
 /**************************************************************************/
 /*!
-   @brief   Draw a single character
-    @param    x   Bottom left corner x coordinate
-    @param    y   Bottom left corner y coordinate
-    @param    c   The 8-bit font-indexed character (likely ascii)
-    @param    color 16-bit 5-6-5 Color to draw chraracter with
-    @param    bg 16-bit 5-6-5 Color to fill background with (if same as color,
-   no background)
-    @param    size_x  Font magnification level in X-axis, 1 is 'original' size
-    @param    size_y  Font magnification level in Y-axis, 1 is 'original' size
+   @brief      Draw a RAM-resident 1-bit image at the specified (x,y) position,
+   using the specified foreground (for set bits) and background (unset bits)
+   colors.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    color 16-bit 5-6-5 Color to draw pixels with
+    @param    bg 16-bit 5-6-5 Color to draw background with
 */
 /**************************************************************************/
-void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
-                            uint16_t color, uint16_t bg, uint8_t size_x,
-                            uint8_t size_y) {
-
-  if (!gfxFont) { // 'Classic' built-in font
-
-    if ((x >= _width) ||              // Clip right
-        (y >= _height) ||             // Clip bottom
-        ((x + 6 * size_x - 1) < 0) || // Clip left
-        ((y + 8 * size_y - 1) < 0))   // Clip top
-      return;
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                              int16_t h, uint16_t color, uint16_t bg) {
+  if (clipReject(x, y, w, h))
+    return;
 
-    if (!_cp437 && (c >= 176))
-      c++; // Handle 'classic' charset behavior
+  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
+  uint8_t b = 0;
 
-    startWrite();
-    for (int8_t i = 0; i < 5; i++) { // Char bitmap = 5 columns
-      uint8_t line = pgm_read_byte(&font[c * 5 + i]);
-      for (int8_t j = 0; j < 8; j++, line >>= 1) {
-        if (line & 1) {
-          if (size_x == 1 && size_y == 1)
-            writePixel(x + i, y + j, color);
-          else
-            writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y,
-                          color);
-        } else if (bg != color) {
-          if (size_x == 1 && size_y == 1)
-            writePixel(x + i, y + j, bg);
-          else
-            writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, bg);
-        }
-      }
-    }
-    if (bg != color) { // If opaque, draw vertical line for last column
-      if (size_x == 1 && size_y == 1)
-        writeFastVLine(x + 5, y, 8, bg);
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (i & 7)
+        b <<= 1;
       else
-        writeFillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
+        b = bitmap[j * byteWidth + i / 8];
+      writePixel(x + i, y, (b & 0x80) ? color : bg);
     }
-    endWrite();
+  }
+  endWrite();
+}
 
-  } else { // Custom font
+/**************************************************************************/
+/*!
+   @brief      Draw PROGMEM-resident XBitMap Files (*.xbm), exported from GIMP.
+   Usage: Export from GIMP to *.xbm, rename *.xbm to *.c and open in editor.
+   C Array can be directly used with this function.
+   There is no RAM-resident version of this function; if generating bitmaps
+   in RAM, use the format defined by drawBitmap() and call that instead.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    color 16-bit 5-6-5 Color to draw pixels with
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                               int16_t w, int16_t h, uint16_t color) {
+  if (clipReject(x, y, w, h))
+    return;
 
-    // Character is assumed previously filtered by write() to eliminate
-    // newlines, returns, non-printable characters, etc.  Calling
-    // drawChar() directly with 'bad' characters of font may cause mayhem!
+  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
+  uint8_t b = 0;
 
-    c -= (uint8_t)pgm_read_byte(&gfxFont->first);
-    GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c);
-    uint8_t *bitmap = pgm_read_bitmap_ptr(gfxFont);
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (i & 7)
+        b >>= 1;
+      else
+        b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+      // Nearly identical to drawBitmap(), only the bit order
+      // is reversed here (left-to-right = LSB to MSB):
+      if (b & 0x01)
+        writePixel(x + i, y, color);
+    }
+  }
+  endWrite();
+}
 
-    uint16_t bo = pgm_read_word(&glyph->bitmapOffset);
-    uint8_t w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
-    int8_t xo = pgm_read_byte(&glyph->xOffset),
-           yo = pgm_read_byte(&glyph->yOffset);
-    uint8_t xx, yy, bits = 0, bit = 0;
-    int16_t xo16 = 0, yo16 = 0;
+/**************************************************************************/
+/*!
+   @brief   Draw a PROGMEM-resident 8-bit image (grayscale) at the specified
+   (x,y) pos. Specifically for 8-bit display devices such as IS31FL3731; no
+   color reduction/expansion is performed.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with grayscale bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
+                                       const uint8_t bitmap[], int16_t w,
+                                       int16_t h) {
+  if (clipReject(x, y, w, h))
+    return;
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) {
+      writePixel(x + i, y, (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
+    }
+  }
+  endWrite();
+}
 
-    if (size_x > 1 || size_y > 1) {
-      xo16 = xo;
-      yo16 = yo;
+/**************************************************************************/
+/*!
+   @brief   Draw a RAM-resident 8-bit image (grayscale) at the specified (x,y)
+   pos. Specifically for 8-bit display devices such as IS31FL3731; no color
+   reduction/expansion is performed.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with grayscale bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                       int16_t w, int16_t h) {
+  if (clipReject(x, y, w, h))
+    return;
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) {
+      writePixel(x + i, y, bitmap[j * w + i]);
     }
+  }
+  endWrite();
+}
 
-    // Todo: Add character clipping here
+/**************************************************************************/
+/*!
+   @brief   Draw a PROGMEM-resident 8-bit image (grayscale) with a 1-bit mask
+   (set bits = opaque, unset bits = clear) at the specified (x,y) position.
+   BOTH buffers (grayscale and mask) must be PROGMEM-resident.
+   Specifically for 8-bit display devices such as IS31FL3731; no color
+   reduction/expansion is performed.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with grayscale bitmap
+    @param    mask  byte array with mask bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
+                                       const uint8_t bitmap[],
+                                       const uint8_t mask[], int16_t w,
+                                       int16_t h) {
+  if (clipReject(x, y, w, h))
+    return;
+  int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
+  uint8_t b = 0;
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (i & 7)
+        b <<= 1;
+      else
+        b = pgm_read_byte(&mask[j * bw + i / 8]);
+      if (b & 0x80) {
+        writePixel(x + i, y, (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
+      }
+    }
+  }
+  endWrite();
+}
 
-    // NOTE: THERE IS NO 'BACKGROUND' COLOR OPTION ON CUSTOM FONTS.
-    // THIS IS ON PURPOSE AND BY DESIGN.  The background color feature
+/**************************************************************************/
+/*!
+   @brief   Draw a RAM-resident 8-bit image (grayscale) with a 1-bit mask
+   (set bits = opaque, unset bits = clear) at the specified (x,y) position.
+   BOTH buffers (grayscale and mask) must be RAM-residentt, no mix-and-match
+   Specifically for 8-bit display devices such as IS31FL3731; no color
+   reduction/expansion is performed.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with grayscale bitmap
+    @param    mask  byte array with mask bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                       uint8_t *mask, int16_t w, int16_t h) {
+  if (clipReject(x, y, w, h))
+    return;
+  int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
+  uint8_t b = 0;
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (i & 7)
+        b <<= 1;
+      else
+        b = mask[j * bw + i / 8];
+      if (b & 0x80) {
+        writePixel(x + i, y, bitmap[j * w + i]);
+      }
+    }
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a PROGMEM-resident 16-bit image (RGB 5/6/5) at the specified
+   (x,y) position. For 16-bit display devices; no color reduction performed.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with 16-bit color bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
+                                 int16_t w, int16_t h) {
+  if (clipReject(x, y, w, h))
+    return;
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) {
+      writePixel(x + i, y, pgm_read_word(&bitmap[j * w + i]));
+    }
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a RAM-resident 16-bit image (RGB 5/6/5) at the specified (x,y)
+   position. For 16-bit display devices; no color reduction performed.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with 16-bit color bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
+                                 int16_t w, int16_t h) {
+  if (clipReject(x, y, w, h))
+    return;
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) {
+      writePixel(x + i, y, bitmap[j * w + i]);
+    }
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a PROGMEM-resident 16-bit image (RGB 5/6/5) with a 1-bit mask
+   (set bits = opaque, unset bits = clear) at the specified (x,y) position. BOTH
+   buffers (color and mask) must be PROGMEM-resident. For 16-bit display
+   devices; no color reduction performed.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with 16-bit color bitmap
+    @param    mask  byte array with monochrome mask bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
+                                 const uint8_t mask[], int16_t w, int16_t h) {
+  if (clipReject(x, y, w, h))
+    return;
+  int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
+  uint8_t b = 0;
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (i & 7)
+        b <<= 1;
+      else
+        b = pgm_read_byte(&mask[j * bw + i / 8]);
+      if (b & 0x80) {
+        writePixel(x + i, y, pgm_read_word(&bitmap[j * w + i]));
+      }
+    }
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a RAM-resident 16-bit image (RGB 5/6/5) with a 1-bit mask (set
+   bits = opaque, unset bits = clear) at the specified (x,y) position. BOTH
+   buffers (color and mask) must be RAM-resident. For 16-bit display devices; no
+   color reduction performed.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with 16-bit color bitmap
+    @param    mask  byte array with monochrome mask bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
+                                 uint8_t *mask, int16_t w, int16_t h) {
+  if (clipReject(x, y, w, h))
+    return;
+  int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
+  uint8_t b = 0;
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (i & 7)
+        b <<= 1;
+      else
+        b = mask[j * bw + i / 8];
+      if (b & 0x80) {
+        writePixel(x + i, y, bitmap[j * w + i]);
+      }
+    }
+  }
+  endWrite();
+}
+
+// TEXT- AND CHARACTER-HANDLING FUNCTIONS ----------------------------------
+
+// Draw a character
+/**************************************************************************/
+/*!
+   @brief   Draw a single character
+    @param    x   Bottom left corner x coordinate
+    @param    y   Bottom left corner y coordinate
+    @param    c   The 8-bit font-indexed character (likely ascii)
+    @param    color 16-bit 5-6-5 Color to draw chraracter with
+    @param    bg 16-bit 5-6-5 Color to fill background with (if same as color,
+   no background)
+    @param    size  Font magnification level, 1 is 'original' size
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
+                            uint16_t color, uint16_t bg, uint8_t size) {
+  drawChar(x, y, c, color, bg, size, size);
+}
+
+// Draw a character
+/**************************************************************************/
+/*!
+   @brief   Draw a single character
+    @param    x   Bottom left corner x coordinate
+    @param    y   Bottom left corner y coordinate
+    @param    c   The 8-bit font-indexed character (likely ascii)
+    @param    color 16-bit 5-6-5 Color to draw chraracter with
+    @param    bg 16-bit 5-6-5 Color to fill background with (if same as color,
+   no background)
+    @param    size_x  Font magnification level in X-axis, 1 is 'original' size
+    @param    size_y  Font magnification level in Y-axis, 1 is 'original' size
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
+                            uint16_t color, uint16_t bg, uint8_t size_x,
+                            uint8_t size_y) {
+
+  if (!gfxFont) { // 'Classic' built-in font
+
+    if (clipReject(x, y, 6 * size_x, 8 * size_y))
+      return;
+
+    if (!_cp437 && (c >= 176))
+      c++; // Handle 'classic' charset behavior
+
+    startWrite();
+    for (int8_t i = 0; i < 5; i++) { // Char bitmap = 5 columns
+      uint8_t line = pgm_read_byte(&font[c * 5 + i]);
+      for (int8_t j = 0; j < 8; j++, line >>= 1) {
+        if (line & 1) {
+          if (size_x == 1 && size_y == 1)
+            writePixel(x + i, y + j, color);
+          else
+            writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y,
+                          color);
+        } else if (bg != color) {
+          if (size_x == 1 && size_y == 1)
+            writePixel(x + i, y + j, bg);
+          else
+            writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, bg);
+        }
+      }
+    }
+    if (bg != color) { // If opaque, draw vertical line for last column
+      if (size_x == 1 && size_y == 1)
+        writeFastVLine(x + 5, y, 8, bg);
+      else
+        writeFillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
+    }
+    endWrite();
+
+  } else { // Custom font
+
+    // Character is assumed previously filtered by write() to eliminate
+    // newlines, returns, non-printable characters, etc.  Calling
+    // drawChar() directly with 'bad' characters of font may cause mayhem!
+
+    c -= (uint8_t)pgm_read_byte(&gfxFont->first);
+    GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c);
+    uint8_t *bitmap = pgm_read_bitmap_ptr(gfxFont);
+
+    uint16_t bo = pgm_read_word(&glyph->bitmapOffset);
+    uint8_t w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
+    int8_t xo = pgm_read_byte(&glyph->xOffset),
+           yo = pgm_read_byte(&glyph->yOffset);
+    uint8_t xx, yy, bits = 0, bit = 0;
+    int16_t xo16 = 0, yo16 = 0;
+
+    if (size_x > 1 || size_y > 1) {
+      xo16 = xo;
+      yo16 = yo;
+    }
+
+    if (!w || !h || clipReject(x + xo * size_x, y + yo * size_y, w * size_x,
+                               h * size_y))
+      return; // Blank or clipped glyph
+
+    // NOTE: THERE IS NO 'BACKGROUND' COLOR OPTION ON CUSTOM FONTS.
+    // THIS IS ON PURPOSE AND BY DESIGN.  The background color feature
     // has typically been used with the 'classic' font to overwrite old
     // screen contents with new data.  This ONLY works because the
     // characters are a uniform size; it's not a sensible thing to do with
@@ -1231,538 +2392,1490 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
     }
     endWrite();
 
-  } // End classic vs custom font
+  } // End classic vs custom font
+}
+/**************************************************************************/
+/*!
+    @brief  Print one byte/character of data, used to support print()
+    @param  c  The 8-bit ascii character to write
+*/
+/**************************************************************************/
+size_t Adafruit_GFX::write(uint8_t c) {
+  if (!gfxFont) { // 'Classic' built-in font
+
+    if (c == '\n') {              // Newline?
+      cursor_x = 0;               // Reset x to zero,
+      cursor_y += textsize_y * 8; // advance y one line
+    } else if (c != '\r') {       // Ignore carriage returns
+      if (wrap && ((cursor_x + textsize_x * 6) > view_w)) { // Off right?
+        cursor_x = 0;                                       // Reset x to zero,
+        cursor_y += textsize_y * 8; // advance y one line
+      }
+      drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x,
+               textsize_y);
+      cursor_x += textsize_x * 6; // Advance x one char
+    }
+
+  } else { // Custom font
+
+    if (c == '\n') {
+      cursor_x = 0;
+      cursor_y +=
+          (int16_t)textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+    } else if (c != '\r') {
+      uint8_t first = pgm_read_byte(&gfxFont->first);
+      if ((c >= first) && (c <= (uint8_t)pgm_read_byte(&gfxFont->last))) {
+        GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - first);
+        uint8_t w = pgm_read_byte(&glyph->width),
+                h = pgm_read_byte(&glyph->height);
+        if ((w > 0) && (h > 0)) { // Is there an associated bitmap?
+          int16_t xo = (int8_t)pgm_read_byte(&glyph->xOffset); // sic
+          if (wrap && ((cursor_x + textsize_x * (xo + w)) > view_w)) {
+            cursor_x = 0;
+            cursor_y += (int16_t)textsize_y *
+                        (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+          }
+          drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x,
+                   textsize_y);
+        }
+        cursor_x +=
+            (uint8_t)pgm_read_byte(&glyph->xAdvance) * (int16_t)textsize_x;
+      }
+    }
+  }
+  return 1;
+}
+
+/**************************************************************************/
+/*!
+    @brief   Set text 'magnification' size. Each increase in s makes 1 pixel
+   that much bigger.
+    @param  s  Desired text size. 1 is default 6x8, 2 is 12x16, 3 is 18x24, etc
+*/
+/**************************************************************************/
+void Adafruit_GFX::setTextSize(uint8_t s) { setTextSize(s, s); }
+
+/**************************************************************************/
+/*!
+    @brief   Set text 'magnification' size. Each increase in s makes 1 pixel
+   that much bigger.
+    @param  s_x  Desired text width magnification level in X-axis. 1 is default
+    @param  s_y  Desired text width magnification level in Y-axis. 1 is default
+*/
+/**************************************************************************/
+void Adafruit_GFX::setTextSize(uint8_t s_x, uint8_t s_y) {
+  textsize_x = (s_x > 0) ? s_x : 1;
+  textsize_y = (s_y > 0) ? s_y : 1;
+}
+
+/**************************************************************************/
+/*!
+    @brief      Set rotation setting for display
+    @param  x   0 thru 3 corresponding to 4 cardinal rotations
+*/
+/**************************************************************************/
+void Adafruit_GFX::setRotation(uint8_t x) {
+  rotation = (x & 3);
+  switch (rotation) {
+  case 0:
+  case 2:
+    _width = WIDTH;
+    _height = HEIGHT;
+    break;
+  case 1:
+  case 3:
+    _width = HEIGHT;
+    _height = WIDTH;
+    break;
+  }
+  resetViewport(); // Screen edges moved
+}
+
+/**************************************************************************/
+/*!
+    @brief Set the font to display when print()ing, either custom or default
+    @param  f  The GFXfont object, if NULL use built in 6x8 font
+*/
+/**************************************************************************/
+void Adafruit_GFX::setFont(const GFXfont *f) {
+  if (f) {          // Font struct pointer passed in?
+    if (!gfxFont) { // And no current font struct?
+      // Switching from classic to new font behavior.
+      // Move cursor pos down 6 pixels so it's on baseline.
+      cursor_y += 6;
+    }
+  } else if (gfxFont) { // NULL passed.  Current font struct defined?
+    // Switching from new to classic font behavior.
+    // Move cursor pos up 6 pixels so it's at top-left of char.
+    cursor_y -= 6;
+  }
+  gfxFont = (GFXfont *)f;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Helper to determine size of a character with current font/size.
+            Broke this out as it's used by both the PROGMEM- and RAM-resident
+            getTextBounds() functions.
+    @param  c     The ASCII character in question
+    @param  x     Pointer to x location of character. Value is modified by
+                  this function to advance to next character.
+    @param  y     Pointer to y location of character. Value is modified by
+                  this function to advance to next character.
+    @param  minx  Pointer to minimum X coordinate, passed in to AND returned
+                  by this function -- this is used to incrementally build a
+                  bounding rectangle for a string.
+    @param  miny  Pointer to minimum Y coord, passed in AND returned.
+    @param  maxx  Pointer to maximum X coord, passed in AND returned.
+    @param  maxy  Pointer to maximum Y coord, passed in AND returned.
+*/
+/**************************************************************************/
+void Adafruit_GFX::charBounds(unsigned char c, int16_t *x, int16_t *y,
+                              int16_t *minx, int16_t *miny, int16_t *maxx,
+                              int16_t *maxy) {
+
+  if (gfxFont) {
+
+    if (c == '\n') { // Newline?
+      *x = 0;        // Reset x to zero, advance y by one line
+      *y += textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+    } else if (c != '\r') { // Not a carriage return; is normal char
+      uint8_t first = pgm_read_byte(&gfxFont->first),
+              last = pgm_read_byte(&gfxFont->last);
+      if ((c >= first) && (c <= last)) { // Char present in this font?
+        GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - first);
+        uint8_t gw = pgm_read_byte(&glyph->width),
+                gh = pgm_read_byte(&glyph->height),
+                xa = pgm_read_byte(&glyph->xAdvance);
+        int8_t xo = pgm_read_byte(&glyph->xOffset),
+               yo = pgm_read_byte(&glyph->yOffset);
+        if (wrap && ((*x + (((int16_t)xo + gw) * textsize_x)) > view_w)) {
+          *x = 0; // Reset x to zero, advance y by one line
+          *y += textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+        }
+        int16_t tsx = (int16_t)textsize_x, tsy = (int16_t)textsize_y,
+                x1 = *x + xo * tsx, y1 = *y + yo * tsy, x2 = x1 + gw * tsx - 1,
+                y2 = y1 + gh * tsy - 1;
+        if (x1 < *minx)
+          *minx = x1;
+        if (y1 < *miny)
+          *miny = y1;
+        if (x2 > *maxx)
+          *maxx = x2;
+        if (y2 > *maxy)
+          *maxy = y2;
+        *x += xa * tsx;
+      }
+    }
+
+  } else { // Default font
+
+    if (c == '\n') {        // Newline?
+      *x = 0;               // Reset x to zero,
+      *y += textsize_y * 8; // advance y one line
+      // min/max x/y unchaged -- that waits for next 'normal' character
+    } else if (c != '\r') { // Normal char; ignore carriage returns
+      if (wrap && ((*x + textsize_x * 6) > view_w)) { // Off right?
+        *x = 0;                                       // Reset x to zero,
+        *y += textsize_y * 8;                         // advance y one line
+      }
+      int x2 = *x + textsize_x * 6 - 1, // Lower-right pixel of char
+          y2 = *y + textsize_y * 8 - 1;
+      if (x2 > *maxx)
+        *maxx = x2; // Track max x, y
+      if (y2 > *maxy)
+        *maxy = y2;
+      if (*x < *minx)
+        *minx = *x; // Track min x, y
+      if (*y < *miny)
+        *miny = *y;
+      *x += textsize_x * 6; // Advance x one char
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Helper to determine size of a string with current font/size.
+            Pass string and a cursor position, returns UL corner and W,H.
+    @param  str  The ASCII string to measure
+    @param  x    The current cursor X
+    @param  y    The current cursor Y
+    @param  x1   The boundary X coordinate, returned by function
+    @param  y1   The boundary Y coordinate, returned by function
+    @param  w    The boundary width, returned by function
+    @param  h    The boundary height, returned by function
+*/
+/**************************************************************************/
+void Adafruit_GFX::getTextBounds(const char *str, int16_t x, int16_t y,
+                                 int16_t *x1, int16_t *y1, uint16_t *w,
+                                 uint16_t *h) {
+
+  uint8_t c; // Current character
+  int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1; // Bound rect
+  // Bound rect is intentionally initialized inverted, so 1st char sets it
+
+  *x1 = x; // Initial position is value passed in
+  *y1 = y;
+  *w = *h = 0; // Initial size is zero
+
+  while ((c = *str++)) {
+    // charBounds() modifies x/y to advance for each character,
+    // and min/max x/y are updated to incrementally build bounding rect.
+    charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+  }
+
+  if (maxx >= minx) {     // If legit string bounds were found...
+    *x1 = minx;           // Update x1 to least X coord,
+    *w = maxx - minx + 1; // And w to bound rect width
+  }
+  if (maxy >= miny) { // Same for height
+    *y1 = miny;
+    *h = maxy - miny + 1;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief    Helper to determine size of a string with current font/size. Pass
+   string and a cursor position, returns UL corner and W,H.
+    @param    str    The ascii string to measure (as an arduino String() class)
+    @param    x      The current cursor X
+    @param    y      The current cursor Y
+    @param    x1     The boundary X coordinate, set by function
+    @param    y1     The boundary Y coordinate, set by function
+    @param    w      The boundary width, set by function
+    @param    h      The boundary height, set by function
+*/
+/**************************************************************************/
+void Adafruit_GFX::getTextBounds(const String &str, int16_t x, int16_t y,
+                                 int16_t *x1, int16_t *y1, uint16_t *w,
+                                 uint16_t *h) {
+  if (str.length() != 0) {
+    getTextBounds(const_cast<char *>(str.c_str()), x, y, x1, y1, w, h);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief    Helper to determine size of a PROGMEM string with current
+   font/size. Pass string and a cursor position, returns UL corner and W,H.
+    @param    str     The flash-memory ascii string to measure
+    @param    x       The current cursor X
+    @param    y       The current cursor Y
+    @param    x1      The boundary X coordinate, set by function
+    @param    y1      The boundary Y coordinate, set by function
+    @param    w      The boundary width, set by function
+    @param    h      The boundary height, set by function
+*/
+/**************************************************************************/
+void Adafruit_GFX::getTextBounds(const __FlashStringHelper *str, int16_t x,
+                                 int16_t y, int16_t *x1, int16_t *y1,
+                                 uint16_t *w, uint16_t *h) {
+  uint8_t *s = (uint8_t *)str, c;
+
+  *x1 = x;
+  *y1 = y;
+  *w = *h = 0;
+
+  int16_t minx = _width, miny = _height, maxx = -1, maxy = -1;
+
+  while ((c = pgm_read_byte(s++)))
+    charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+
+  if (maxx >= minx) {
+    *x1 = minx;
+    *w = maxx - minx + 1;
+  }
+  if (maxy >= miny) {
+    *y1 = miny;
+    *h = maxy - miny + 1;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief      Invert the display (ideally using built-in hardware command)
+    @param   i  True if you want to invert, false to make 'normal'
+*/
+/**************************************************************************/
+void Adafruit_GFX::invertDisplay(bool i) {
+  // Do nothing, must be subclassed if supported by hardware
+  (void)i; // disable -Wunused-parameter warning
+}
+
+/**************************************************************************/
+/*!
+    @brief  Limit drawing to a rectangle, inside any area already pushed.
+            Every primitive is clipped to it, and skips its work entirely
+            if it lies outside, so repainting a small region costs only
+            what lands there. Undo with popClipRect().
+    @param  x  Left edge, viewport relative
+    @param  y  Top edge, viewport relative
+    @param  w  Width
+    @param  h  Height
+    @returns false (nothing changed) if GFX_CLIP_DEPTH rectangles are
+             already pushed
+*/
+/**************************************************************************/
+bool Adafruit_GFX::pushClipRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if (clip_depth >= GFX_CLIP_DEPTH)
+    return false;
+  GFXrect &saved = clip_stack[clip_depth++];
+  saved.x = clip_x0;
+  saved.y = clip_y0;
+  saved.w = clip_x1 - clip_x0;
+  saved.h = clip_y1 - clip_y0;
+  // Intersect with the current area, in 32 bits so edges can't overflow
+  int32_t x0 = (int32_t)x + origin_x, y0 = (int32_t)y + origin_y;
+  int32_t x1 = x0 + w, y1 = y0 + h;
+  if (x0 > clip_x0)
+    clip_x0 = x0;
+  if (y0 > clip_y0)
+    clip_y0 = y0;
+  if (x1 < clip_x1)
+    clip_x1 = x1;
+  if (y1 < clip_y1)
+    clip_y1 = y1;
+  if (clip_x1 < clip_x0) // Nothing left, keep it empty but ordered
+    clip_x1 = clip_x0;
+  if (clip_y1 < clip_y0)
+    clip_y1 = clip_y0;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Go back to the clip area in effect before the last
+            pushClipRect(). Does nothing if none is pushed.
+*/
+/**************************************************************************/
+void Adafruit_GFX::popClipRect(void) {
+  if (clip_depth) {
+    GFXrect &r = clip_stack[--clip_depth];
+    clip_x0 = r.x;
+    clip_y0 = r.y;
+    clip_x1 = r.x + r.w;
+    clip_y1 = r.y + r.h;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Drop all pushed clip rectangles so the whole viewport can be
+            drawn again
+*/
+/**************************************************************************/
+void Adafruit_GFX::resetClip(void) {
+  int32_t x1 = (int32_t)origin_x + view_w, y1 = (int32_t)origin_y + view_h;
+  clip_x0 = (origin_x > 0) ? origin_x : 0;
+  clip_y0 = (origin_y > 0) ? origin_y : 0;
+  clip_x1 = (x1 < _width) ? x1 : _width;
+  clip_y1 = (y1 < _height) ? y1 : _height;
+  if (clip_x1 < clip_x0) // Viewport off screen
+    clip_x1 = clip_x0;
+  if (clip_y1 < clip_y0)
+    clip_y1 = clip_y0;
+  clip_depth = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw into a window of the screen in its own coordinates: (0,0)
+            becomes (x,y), and nothing is drawn outside the window, so the
+            same widget code renders anywhere (or into a small canvas with
+            no viewport) unchanged. Geometry outside is rejected before it
+            is sent. Canvas getPixel() reads in the same coordinates.
+            Pushed clip rectangles are dropped; setRotation() resets the
+            viewport to the whole screen.
+    @param  x  Left edge on screen, may be negative
+    @param  y  Top edge on screen, may be negative
+    @param  w  Width
+    @param  h  Height
+*/
+/**************************************************************************/
+void Adafruit_GFX::setViewport(int16_t x, int16_t y, int16_t w, int16_t h) {
+  origin_x = x;
+  origin_y = y;
+  view_w = (w > 0) ? w : 0;
+  view_h = (h > 0) ? h : 0;
+  resetClip();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clip a run of pixels along one axis
+    @param  a   Pointer to start (end if n is negative); set to the first
+                pixel inside [lo, hi)
+    @param  n   Pointer to length, may be negative; set to the length left
+    @param  lo  First pixel allowed
+    @param  hi  Pixel past the last one allowed
+    @returns true if any of the run is left
+*/
+/**************************************************************************/
+static bool clipSpan(int16_t *a, int16_t *n, int16_t lo, int16_t hi) {
+  int32_t a0 = *a, a1 = (int32_t)*a + *n; // a1 exclusive, in 32 bits
+  if (*n < 0) {                           // Negative length: a is the end
+    a0 = a1 + 1;
+    a1 = *a + 1;
+  }
+  if (a0 < lo)
+    a0 = lo;
+  if (a1 > hi)
+    a1 = hi;
+  if (a0 >= a1)
+    return false;
+  *a = a0;
+  *n = a1 - a0;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clip a horizontal line, for drawFastHLine() implementations
+    @param  x  Pointer to left end (or right end if w is negative); set to
+               the left end of the visible part, in screen coordinates
+    @param  y  Pointer to row; moved to screen coordinates
+    @param  w  Pointer to width, may be negative; set to the visible width
+    @returns true if any of the line should be drawn
+*/
+/**************************************************************************/
+bool Adafruit_GFX::clipHLine(int16_t *x, int16_t *y, int16_t *w) const {
+  *x += origin_x;
+  *y += origin_y;
+  return (*y >= clip_y0) && (*y < clip_y1) &&
+         clipSpan(x, w, clip_x0, clip_x1);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clip a vertical line, for drawFastVLine() implementations
+    @param  x  Pointer to column; moved to screen coordinates
+    @param  y  Pointer to top end (or bottom end if h is negative); set to
+               the top end of the visible part, in screen coordinates
+    @param  h  Pointer to height, may be negative; set to the visible height
+    @returns true if any of the line should be drawn
+*/
+/**************************************************************************/
+bool Adafruit_GFX::clipVLine(int16_t *x, int16_t *y, int16_t *h) const {
+  *x += origin_x;
+  *y += origin_y;
+  return (*x >= clip_x0) && (*x < clip_x1) &&
+         clipSpan(y, h, clip_y0, clip_y1);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clip a rectangle, for fillRect() implementations
+    @param  x  Pointer to left edge (right edge if w is negative); set to
+               the left edge of the visible part, in screen coordinates
+    @param  y  Pointer to top edge (bottom edge if h is negative); set to
+               the top edge of the visible part, in screen coordinates
+    @param  w  Pointer to width, may be negative; set to the visible width
+    @param  h  Pointer to height, may be negative; set to the visible height
+    @returns true if any of the rectangle should be drawn
+*/
+/**************************************************************************/
+bool Adafruit_GFX::clipRect(int16_t *x, int16_t *y, int16_t *w,
+                            int16_t *h) const {
+  int16_t x1 = *x + origin_x, w1 = *w;
+  *y += origin_y;
+  if (!*h || !clipSpan(&x1, &w1, clip_x0, clip_x1) ||
+      !clipSpan(y, h, clip_y0, clip_y1))
+    return false;
+  *x = x1;
+  *w = w1;
+  return true;
+}
+
+/***************************************************************************/
+
+/**************************************************************************/
+/*!
+   @brief    Create a simple drawn button UI element
+*/
+/**************************************************************************/
+Adafruit_GFX_Button::Adafruit_GFX_Button(void) { _gfx = 0; }
+
+/**************************************************************************/
+/*!
+   @brief    Initialize button with our desired color/size/settings
+   @param    gfx     Pointer to our display so we can draw to it!
+   @param    x       The X coordinate of the center of the button
+   @param    y       The Y coordinate of the center of the button
+   @param    w       Width of the buttton
+   @param    h       Height of the buttton
+   @param    outline  Color of the outline (16-bit 5-6-5 standard)
+   @param    fill  Color of the button fill (16-bit 5-6-5 standard)
+   @param    textcolor  Color of the button label (16-bit 5-6-5 standard)
+   @param    label  Ascii string of the text inside the button
+   @param    textsize The font magnification of the label text
+*/
+/**************************************************************************/
+// Classic initButton() function: pass center & size
+void Adafruit_GFX_Button::initButton(Adafruit_GFX *gfx, int16_t x, int16_t y,
+                                     uint16_t w, uint16_t h, uint16_t outline,
+                                     uint16_t fill, uint16_t textcolor,
+                                     char *label, uint8_t textsize) {
+  // Tweak arguments and pass to the newer initButtonUL() function...
+  initButtonUL(gfx, x - (w / 2), y - (h / 2), w, h, outline, fill, textcolor,
+               label, textsize);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Initialize button with our desired color/size/settings
+   @param    gfx     Pointer to our display so we can draw to it!
+   @param    x       The X coordinate of the center of the button
+   @param    y       The Y coordinate of the center of the button
+   @param    w       Width of the buttton
+   @param    h       Height of the buttton
+   @param    outline  Color of the outline (16-bit 5-6-5 standard)
+   @param    fill  Color of the button fill (16-bit 5-6-5 standard)
+   @param    textcolor  Color of the button label (16-bit 5-6-5 standard)
+   @param    label  Ascii string of the text inside the button
+   @param    textsize_x The font magnification in X-axis of the label text
+   @param    textsize_y The font magnification in Y-axis of the label text
+*/
+/**************************************************************************/
+// Classic initButton() function: pass center & size
+void Adafruit_GFX_Button::initButton(Adafruit_GFX *gfx, int16_t x, int16_t y,
+                                     uint16_t w, uint16_t h, uint16_t outline,
+                                     uint16_t fill, uint16_t textcolor,
+                                     char *label, uint8_t textsize_x,
+                                     uint8_t textsize_y) {
+  // Tweak arguments and pass to the newer initButtonUL() function...
+  initButtonUL(gfx, x - (w / 2), y - (h / 2), w, h, outline, fill, textcolor,
+               label, textsize_x, textsize_y);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Initialize button with our desired color/size/settings, with
+   upper-left coordinates
+   @param    gfx     Pointer to our display so we can draw to it!
+   @param    x1       The X coordinate of the Upper-Left corner of the button
+   @param    y1       The Y coordinate of the Upper-Left corner of the button
+   @param    w       Width of the buttton
+   @param    h       Height of the buttton
+   @param    outline  Color of the outline (16-bit 5-6-5 standard)
+   @param    fill  Color of the button fill (16-bit 5-6-5 standard)
+   @param    textcolor  Color of the button label (16-bit 5-6-5 standard)
+   @param    label  Ascii string of the text inside the button
+   @param    textsize The font magnification of the label text
+*/
+/**************************************************************************/
+void Adafruit_GFX_Button::initButtonUL(Adafruit_GFX *gfx, int16_t x1,
+                                       int16_t y1, uint16_t w, uint16_t h,
+                                       uint16_t outline, uint16_t fill,
+                                       uint16_t textcolor, char *label,
+                                       uint8_t textsize) {
+  initButtonUL(gfx, x1, y1, w, h, outline, fill, textcolor, label, textsize,
+               textsize);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Initialize button with our desired color/size/settings, with
+   upper-left coordinates
+   @param    gfx     Pointer to our display so we can draw to it!
+   @param    x1       The X coordinate of the Upper-Left corner of the button
+   @param    y1       The Y coordinate of the Upper-Left corner of the button
+   @param    w       Width of the buttton
+   @param    h       Height of the buttton
+   @param    outline  Color of the outline (16-bit 5-6-5 standard)
+   @param    fill  Color of the button fill (16-bit 5-6-5 standard)
+   @param    textcolor  Color of the button label (16-bit 5-6-5 standard)
+   @param    label  Ascii string of the text inside the button
+   @param    textsize_x The font magnification in X-axis of the label text
+   @param    textsize_y The font magnification in Y-axis of the label text
+*/
+/**************************************************************************/
+void Adafruit_GFX_Button::initButtonUL(Adafruit_GFX *gfx, int16_t x1,
+                                       int16_t y1, uint16_t w, uint16_t h,
+                                       uint16_t outline, uint16_t fill,
+                                       uint16_t textcolor, char *label,
+                                       uint8_t textsize_x, uint8_t textsize_y) {
+  _x1 = x1;
+  _y1 = y1;
+  _w = w;
+  _h = h;
+  _outlinecolor = outline;
+  _fillcolor = fill;
+  _textcolor = textcolor;
+  _textsize_x = textsize_x;
+  _textsize_y = textsize_y;
+  _gfx = gfx;
+  strncpy(_label, label, 9);
+  _label[9] = 0; // strncpy does not place a null at the end.
+                 // When 'label' is >9 characters, _label is not terminated.
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw the button on the screen
+   @param    inverted Whether to draw with fill/text swapped to indicate
+   'pressed'
+*/
+/**************************************************************************/
+void Adafruit_GFX_Button::drawButton(bool inverted) {
+  uint16_t fill, outline, text;
+
+  if (!inverted) {
+    fill = _fillcolor;
+    outline = _outlinecolor;
+    text = _textcolor;
+  } else {
+    fill = _textcolor;
+    outline = _outlinecolor;
+    text = _fillcolor;
+  }
+
+  uint8_t r = min(_w, _h) / 4; // Corner radius
+  _gfx->fillRoundRect(_x1, _y1, _w, _h, r, fill);
+  _gfx->drawRoundRect(_x1, _y1, _w, _h, r, outline);
+
+  _gfx->setCursor(_x1 + (_w / 2) - (strlen(_label) * 3 * _textsize_x),
+                  _y1 + (_h / 2) - (4 * _textsize_y));
+  _gfx->setTextColor(text);
+  _gfx->setTextSize(_textsize_x, _textsize_y);
+  _gfx->print(_label);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Helper to let us know if a coordinate is within the bounds of the
+   button
+    @param    x       The X coordinate to check
+    @param    y       The Y coordinate to check
+    @returns  True if within button graphics outline
+*/
+/**************************************************************************/
+bool Adafruit_GFX_Button::contains(int16_t x, int16_t y) {
+  return ((x >= _x1) && (x < (int16_t)(_x1 + _w)) && (y >= _y1) &&
+          (y < (int16_t)(_y1 + _h)));
 }
+
 /**************************************************************************/
 /*!
-    @brief  Print one byte/character of data, used to support print()
-    @param  c  The 8-bit ascii character to write
+   @brief    Query whether the button was pressed since we last checked state
+   @returns  True if was not-pressed before, now is.
 */
 /**************************************************************************/
-size_t Adafruit_GFX::write(uint8_t c) {
-  if (!gfxFont) { // 'Classic' built-in font
+bool Adafruit_GFX_Button::justPressed() { return (currstate && !laststate); }
 
-    if (c == '\n') {              // Newline?
-      cursor_x = 0;               // Reset x to zero,
-      cursor_y += textsize_y * 8; // advance y one line
-    } else if (c != '\r') {       // Ignore carriage returns
-      if (wrap && ((cursor_x + textsize_x * 6) > _width)) { // Off right?
-        cursor_x = 0;                                       // Reset x to zero,
-        cursor_y += textsize_y * 8; // advance y one line
-      }
-      drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x,
-               textsize_y);
-      cursor_x += textsize_x * 6; // Advance x one char
-    }
+/**************************************************************************/
+/*!
+   @brief    Query whether the button was released since we last checked state
+   @returns  True if was pressed before, now is not.
+*/
+/**************************************************************************/
+bool Adafruit_GFX_Button::justReleased() { return (!currstate && laststate); }
 
-  } else { // Custom font
+// -------------------------------------------------------------------------
 
-    if (c == '\n') {
-      cursor_x = 0;
-      cursor_y +=
-          (int16_t)textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
-    } else if (c != '\r') {
-      uint8_t first = pgm_read_byte(&gfxFont->first);
-      if ((c >= first) && (c <= (uint8_t)pgm_read_byte(&gfxFont->last))) {
-        GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - first);
-        uint8_t w = pgm_read_byte(&glyph->width),
-                h = pgm_read_byte(&glyph->height);
-        if ((w > 0) && (h > 0)) { // Is there an associated bitmap?
-          int16_t xo = (int8_t)pgm_read_byte(&glyph->xOffset); // sic
-          if (wrap && ((cursor_x + textsize_x * (xo + w)) > _width)) {
-            cursor_x = 0;
-            cursor_y += (int16_t)textsize_y *
-                        (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
-          }
-          drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x,
-                   textsize_y);
-        }
-        cursor_x +=
-            (uint8_t)pgm_read_byte(&glyph->xAdvance) * (int16_t)textsize_x;
-      }
-    }
-  }
-  return 1;
-}
+// GFXcanvas1, GFXcanvas8 and GFXcanvas16 (currently a WIP, don't get too
+// comfy with the implementation) provide 1-, 8- and 16-bit offscreen
+// canvases, the address of which can be passed to drawBitmap() or
+// pushColors() (the latter appears only in a couple of GFX-subclassed TFT
+// libraries at this time).  This is here mostly to help with the recently-
+// added proportionally-spaced fonts; adds a way to refresh a section of the
+// screen without a massive flickering clear-and-redraw...but maybe you'll
+// find other uses too.  VERY RAM-intensive, since the buffer is in MCU
+// memory and not the display driver...GXFcanvas1 might be minimally useful
+// on an Uno-class board, but this and the others are much more likely to
+// require at least a Mega or various recent ARM-type boards (recommended,
+// as the text+bitmap draw can be pokey).  GFXcanvas1 requires 1 bit per
+// pixel (rounded up to nearest byte per scanline), GFXcanvas8 is 1 byte
+// per pixel (no scanline pad), and GFXcanvas16 uses 2 bytes per pixel (no
+// scanline pad).
+// NOT EXTENSIVELY TESTED YET.  MAY CONTAIN WORST BUGS KNOWN TO HUMANKIND.
+
+#ifdef __AVR__
+// Bitmask tables of 0x80>>X and ~(0x80>>X), because X>>Y is slow on AVR
+const uint8_t PROGMEM GFXcanvas1::GFXsetBit[] = {0x80, 0x40, 0x20, 0x10,
+                                                 0x08, 0x04, 0x02, 0x01};
+const uint8_t PROGMEM GFXcanvas1::GFXclrBit[] = {0x7F, 0xBF, 0xDF, 0xEF,
+                                                 0xF7, 0xFB, 0xFD, 0xFE};
+#endif
+
+// Span fill kernels shared by the canvas classes. Canvas rendering is
+// mostly bound by memory stores, so rather than one store per pixel these
+// replicate the color across a machine word, store single elements until
+// the destination is word-aligned, then do (unrolled) whole-word stores
+// through the middle and finish the tail element-wise. On 8-bit AVR there
+// are no wider stores to gain, so only the element-wise loop is compiled.
+#ifndef __AVR__
+#if UINTPTR_MAX > 0xFFFFFFFFUL
+typedef uint64_t __attribute__((__may_alias__)) GFXword_t; ///< Widest store
+#else
+typedef uint32_t __attribute__((__may_alias__)) GFXword_t; ///< Widest store
+#endif
+#define GFX_WORD_ALIGN (sizeof(GFXword_t) - 1) ///< Address mask for alignment
+#endif
 
 /**************************************************************************/
 /*!
-    @brief   Set text 'magnification' size. Each increase in s makes 1 pixel
-   that much bigger.
-    @param  s  Desired text size. 1 is default 6x8, 2 is 12x16, 3 is 18x24, etc
+   @brief    Fill a run of bytes with one value, a machine word at a time
+   @param    dst    First byte to fill
+   @param    value  Byte value to store
+   @param    n      Number of bytes
 */
 /**************************************************************************/
-void Adafruit_GFX::setTextSize(uint8_t s) { setTextSize(s, s); }
+static void fillBytes(uint8_t *dst, uint8_t value, uint32_t n) {
+#ifndef __AVR__
+  while (n && ((uintptr_t)dst & GFX_WORD_ALIGN)) { // Head, until aligned
+    *dst++ = value;
+    n--;
+  }
+  GFXword_t word = (GFXword_t)-1 / 0xFF * value; // 0x0101...01 * value
+  GFXword_t *wdst = (GFXword_t *)dst;
+  for (; n >= 4 * sizeof(GFXword_t); n -= 4 * sizeof(GFXword_t)) {
+    wdst[0] = word;
+    wdst[1] = word;
+    wdst[2] = word;
+    wdst[3] = word;
+    wdst += 4;
+  }
+  for (; n >= sizeof(GFXword_t); n -= sizeof(GFXword_t))
+    *wdst++ = word;
+  dst = (uint8_t *)wdst;
+#endif
+  while (n--) // Tail (or everything, on AVR)
+    *dst++ = value;
+}
 
 /**************************************************************************/
 /*!
-    @brief   Set text 'magnification' size. Each increase in s makes 1 pixel
-   that much bigger.
-    @param  s_x  Desired text width magnification level in X-axis. 1 is default
-    @param  s_y  Desired text width magnification level in Y-axis. 1 is default
+   @brief    Fill a run of 16-bit pixels with one color, a machine word at a
+             time
+   @param    dst    First pixel to fill
+   @param    color  16-bit value to store
+   @param    n      Number of pixels
 */
 /**************************************************************************/
-void Adafruit_GFX::setTextSize(uint8_t s_x, uint8_t s_y) {
-  textsize_x = (s_x > 0) ? s_x : 1;
-  textsize_y = (s_y > 0) ? s_y : 1;
+static void fillWords(uint16_t *dst, uint16_t color, uint32_t n) {
+#ifndef __AVR__
+  while (n && ((uintptr_t)dst & GFX_WORD_ALIGN)) { // Head, until aligned
+    *dst++ = color;
+    n--;
+  }
+  GFXword_t word = (GFXword_t)-1 / 0xFFFF * color; // 0x00010001... * color
+  GFXword_t *wdst = (GFXword_t *)dst;
+  const uint32_t perWord = sizeof(GFXword_t) / 2;
+  for (; n >= 4 * perWord; n -= 4 * perWord) {
+    wdst[0] = word;
+    wdst[1] = word;
+    wdst[2] = word;
+    wdst[3] = word;
+    wdst += 4;
+  }
+  for (; n >= perWord; n -= perWord)
+    *wdst++ = word;
+  dst = (uint16_t *)wdst;
+#endif
+  while (n--) // Tail (or everything, on AVR)
+    *dst++ = color;
 }
 
 /**************************************************************************/
 /*!
-    @brief      Set rotation setting for display
-    @param  x   0 thru 3 corresponding to 4 cardinal rotations
+   @brief    Map a rectangle from a canvas's rotated coordinates to its raw
+             (unrotated) buffer coordinates
+   @param    rotation  Canvas rotation, 0-3
+   @param    rawW      Raw buffer width
+   @param    rawH      Raw buffer height
+   @param    x         Left edge, in; raw left edge, out
+   @param    y         Top edge, in; raw top edge, out
+   @param    w         Width, in; raw width, out (height if rotated 90/270)
+   @param    h         Height, in; raw height, out
 */
 /**************************************************************************/
-void Adafruit_GFX::setRotation(uint8_t x) {
-  rotation = (x & 3);
+static void rotateRect(uint8_t rotation, int16_t rawW, int16_t rawH,
+                       int16_t *x, int16_t *y, int16_t *w, int16_t *h) {
+  int16_t t;
   switch (rotation) {
-  case 0:
+  case 1:
+    t = *x;
+    *x = rawW - *y - *h;
+    *y = t;
+    t = *w;
+    *w = *h;
+    *h = t;
+    break;
   case 2:
-    _width = WIDTH;
-    _height = HEIGHT;
+    *x = rawW - *x - *w;
+    *y = rawH - *y - *h;
     break;
-  case 1:
   case 3:
-    _width = HEIGHT;
-    _height = WIDTH;
+    t = *y;
+    *y = rawH - *x - *w;
+    *x = t;
+    t = *w;
+    *w = *h;
+    *h = t;
     break;
   }
 }
 
 /**************************************************************************/
 /*!
-    @brief Set the font to display when print()ing, either custom or default
-    @param  f  The GFXfont object, if NULL use built in 6x8 font
+   @brief    Queue a span for spanFill(), unless the row it leads to is
+             outside the fill area
+   @param    work  Pending spans
+   @param    size  Entries in work[]
+   @param    sp    Entries used, updated
+   @param    ok    Cleared if work[] is full and the span is lost
+   @param    y     Row the span is on
+   @param    x1    Left end
+   @param    x2    Right end
+   @param    dy    Row to scan next, relative to y
+   @param    b     Fill area, raw coordinates
 */
 /**************************************************************************/
-void Adafruit_GFX::setFont(const GFXfont *f) {
-  if (f) {          // Font struct pointer passed in?
-    if (!gfxFont) { // And no current font struct?
-      // Switching from classic to new font behavior.
-      // Move cursor pos down 6 pixels so it's on baseline.
-      cursor_y += 6;
+static void fillPush(GFXfillSpan *work, uint16_t size, uint16_t *sp, bool *ok,
+                     int16_t y, int16_t x1, int16_t x2, int8_t dy,
+                     const GFXrect &b) {
+  if ((y + dy < b.y) || (y + dy >= b.y + b.h))
+    return;
+  if (*sp >= size) {
+    *ok = false;
+    return;
+  }
+  GFXfillSpan *s = &work[(*sp)++];
+  s->x1 = x1;
+  s->x2 = x2;
+  s->y = y;
+  s->dy = dy;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Scanline flood fill shared by the canvas classes (Heckbert's
+             seed fill, Graphics Gems I). It runs on the raw buffer, where
+             every span found is one drawFastRawHLine() memory fill, and
+             keeps the spans still to scan in a work buffer instead of
+             recursing, so stack use is fixed.
+   @param    c      Canvas to fill
+   @param    get    The canvas's getRawPixel()
+   @param    hline  The canvas's drawFastRawHLine()
+   @param    x      Seed column, clipped, in rotated canvas coordinates
+   @param    y      Seed row, likewise
+   @param    nv     New pixel value, as getRawPixel() returns it
+   @param    color  New color, as drawFastRawHLine() takes it
+   @param    b      Area the fill stays in (the clip rectangle), rotated
+                    canvas coordinates
+   @param    work   Work buffer, or NULL for GFX_FILL_SPANS on the stack
+   @param    size   Entries in work[]
+   @returns  false if the work buffer ran out, leaving parts unfilled
+*/
+/**************************************************************************/
+template <class C, class P>
+static bool spanFill(C *c, P (C::*get)(int16_t, int16_t) const,
+                     void (C::*hline)(int16_t, int16_t, int16_t, uint16_t),
+                     int16_t x, int16_t y, P nv, uint16_t color, GFXrect b,
+                     GFXfillSpan *work, uint16_t size) {
+  GFXfillSpan stackWork[GFX_FILL_SPANS];
+  if (!work) {
+    work = stackWork;
+    size = GFX_FILL_SPANS;
+  }
+  uint8_t r = c->getRotation();
+  int16_t rawW = (r & 1) ? c->height() : c->width();
+  int16_t rawH = (r & 1) ? c->width() : c->height();
+  int16_t one = 1, t = 1;
+  rotateRect(r, rawW, rawH, &x, &y, &one, &t);
+  rotateRect(r, rawW, rawH, &b.x, &b.y, &b.w, &b.h);
+
+  P ov = (c->*get)(x, y); // The color being replaced
+  if (ov == nv)
+    return true;
+  int16_t xmax = b.x + b.w - 1;
+  uint16_t sp = 0;
+  bool ok = true;
+  fillPush(work, size, &sp, &ok, y, x, x, 1, b);
+  fillPush(work, size, &sp, &ok, y + 1, x, x, -1, b); // Seed row, first
+
+  while (sp) {
+    // A span on the previous row, x1..x2: fill what touches it on this one
+    GFXfillSpan s = work[--sp];
+    int16_t x1 = s.x1, x2 = s.x2, l;
+    int8_t dy = s.dy;
+    y = s.y + dy;
+    if ((c->*get)(x1, y) == ov) {
+      for (l = x1; (l > b.x) && ((c->*get)(l - 1, y) == ov); l--)
+        ;
+      if (l < x1) // Leaks out to the left, check back the other way
+        fillPush(work, size, &sp, &ok, y, l, x1 - 1, -dy, b);
+      x = x1 + 1;
+    } else {
+      for (x = x1 + 1; (x <= x2) && ((c->*get)(x, y) != ov); x++)
+        ;
+      l = x;
+    }
+    while (l <= x2) { // Each run starting under the span
+      for (; (x <= xmax) && ((c->*get)(x, y) == ov); x++)
+        ;
+      (c->*hline)(l, y, x - l, color);
+      fillPush(work, size, &sp, &ok, y, l, x - 1, dy, b);
+      if (x > x2 + 1) // Leaks out to the right
+        fillPush(work, size, &sp, &ok, y, x2 + 1, x - 1, -dy, b);
+      for (x++; (x <= x2) && ((c->*get)(x, y) != ov); x++)
+        ;
+      l = x;
     }
-  } else if (gfxFont) { // NULL passed.  Current font struct defined?
-    // Switching from new to classic font behavior.
-    // Move cursor pos up 6 pixels so it's at top-left of char.
-    cursor_y -= 6;
   }
-  gfxFont = (GFXfont *)f;
+  return ok;
 }
 
 /**************************************************************************/
 /*!
-    @brief  Helper to determine size of a character with current font/size.
-            Broke this out as it's used by both the PROGMEM- and RAM-resident
-            getTextBounds() functions.
-    @param  c     The ASCII character in question
-    @param  x     Pointer to x location of character. Value is modified by
-                  this function to advance to next character.
-    @param  y     Pointer to y location of character. Value is modified by
-                  this function to advance to next character.
-    @param  minx  Pointer to minimum X coordinate, passed in to AND returned
-                  by this function -- this is used to incrementally build a
-                  bounding rectangle for a string.
-    @param  miny  Pointer to minimum Y coord, passed in AND returned.
-    @param  maxx  Pointer to maximum X coord, passed in AND returned.
-    @param  maxy  Pointer to maximum Y coord, passed in AND returned.
+   @brief    Allocate a canvas or driver buffer in a particular kind of
+             memory. Only ESP32 has distinct heaps; elsewhere all SRAM is
+             internal and DMA-capable, and there is no PSRAM. Requests
+             that cannot be met return NULL rather than silently landing
+             somewhere else. Free the result with free().
+   @param    bytes  Size of the buffer
+   @param    where  GFX_MEM_ANY, GFX_MEM_INTERNAL, GFX_MEM_EXTERNAL or
+                    GFX_MEM_DMA
+   @returns  Pointer to the buffer, or NULL
 */
 /**************************************************************************/
-void Adafruit_GFX::charBounds(unsigned char c, int16_t *x, int16_t *y,
-                              int16_t *minx, int16_t *miny, int16_t *maxx,
-                              int16_t *maxy) {
+void *GFXalloc(uint32_t bytes, GFXmemory where) {
+#if defined(ESP32)
+  switch (where) {
+  case GFX_MEM_ANY:
+    return malloc(bytes);
+  case GFX_MEM_INTERNAL:
+    return heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  case GFX_MEM_EXTERNAL:
+    return heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  case GFX_MEM_DMA:
+    return heap_caps_malloc(bytes, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+  default:
+    return NULL;
+  }
+#else
+  if ((where == GFX_MEM_ANY) || (where == GFX_MEM_INTERNAL) ||
+      (where == GFX_MEM_DMA))
+    return malloc(bytes);
+  return NULL;
+#endif
+}
 
-  if (gfxFont) {
+/**************************************************************************/
+/*!
+   @brief    Work out where a buffer returned by GFXalloc() actually is,
+             for the buffer report functions
+   @param    ptr    The buffer, or NULL
+   @param    where  The placement it was requested with
+   @returns  GFX_MEM_NONE if ptr is NULL, the resolved heap for
+             GFX_MEM_ANY, else the requested placement
+*/
+/**************************************************************************/
+GFXmemory GFXmemoryOf(const void *ptr, GFXmemory where) {
+  if (!ptr)
+    return GFX_MEM_NONE;
+  if (where != GFX_MEM_ANY)
+    return where;
+#if defined(ESP32)
+  if (esp_ptr_external_ram(ptr))
+    return GFX_MEM_EXTERNAL;
+#endif
+  return GFX_MEM_INTERNAL;
+}
 
-    if (c == '\n') { // Newline?
-      *x = 0;        // Reset x to zero, advance y by one line
-      *y += textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
-    } else if (c != '\r') { // Not a carriage return; is normal char
-      uint8_t first = pgm_read_byte(&gfxFont->first),
-              last = pgm_read_byte(&gfxFont->last);
-      if ((c >= first) && (c <= last)) { // Char present in this font?
-        GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - first);
-        uint8_t gw = pgm_read_byte(&glyph->width),
-                gh = pgm_read_byte(&glyph->height),
-                xa = pgm_read_byte(&glyph->xAdvance);
-        int8_t xo = pgm_read_byte(&glyph->xOffset),
-               yo = pgm_read_byte(&glyph->yOffset);
-        if (wrap && ((*x + (((int16_t)xo + gw) * textsize_x)) > _width)) {
-          *x = 0; // Reset x to zero, advance y by one line
-          *y += textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
-        }
-        int16_t tsx = (int16_t)textsize_x, tsy = (int16_t)textsize_y,
-                x1 = *x + xo * tsx, y1 = *y + yo * tsy, x2 = x1 + gw * tsx - 1,
-                y2 = y1 + gh * tsy - 1;
-        if (x1 < *minx)
-          *minx = x1;
-        if (y1 < *miny)
-          *miny = y1;
-        if (x2 > *maxx)
-          *maxx = x2;
-        if (y2 > *maxy)
-          *maxy = y2;
-        *x += xa * tsx;
-      }
-    }
+/**************************************************************************/
+/*!
+   @brief    Take a block from the arena, aligned for any pixel type
+   @param    bytes  Size of the block
+   @returns  Pointer to the block, or NULL if the arena is exhausted
+*/
+/**************************************************************************/
+void *GFXarena::alloc(uint32_t bytes) {
+  uintptr_t start = ((uintptr_t)(base + used) + 3) & ~(uintptr_t)3;
+  uint32_t offset = start - (uintptr_t)base;
+  if ((offset > size) || (bytes > size - offset))
+    return NULL;
+  used = offset + bytes;
+  return (void *)start;
+}
 
-  } else { // Default font
+/**************************************************************************/
+/*!
+   @brief    Instatiate a GFX 1-bit canvas context for graphics
+   @param    w   Display width, in pixels
+   @param    h   Display height, in pixels
+*/
+/**************************************************************************/
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h)
+    : GFXcanvas1(w, h, GFX_MEM_ANY) {}
 
-    if (c == '\n') {        // Newline?
-      *x = 0;               // Reset x to zero,
-      *y += textsize_y * 8; // advance y one line
-      // min/max x/y unchaged -- that waits for next 'normal' character
-    } else if (c != '\r') { // Normal char; ignore carriage returns
-      if (wrap && ((*x + textsize_x * 6) > _width)) { // Off right?
-        *x = 0;                                       // Reset x to zero,
-        *y += textsize_y * 8;                         // advance y one line
-      }
-      int x2 = *x + textsize_x * 6 - 1, // Lower-right pixel of char
-          y2 = *y + textsize_y * 8 - 1;
-      if (x2 > *maxx)
-        *maxx = x2; // Track max x, y
-      if (y2 > *maxy)
-        *maxy = y2;
-      if (*x < *minx)
-        *minx = *x; // Track min x, y
-      if (*y < *miny)
-        *miny = *y;
-      *x += textsize_x * 6; // Advance x one char
-    }
-  }
+/**************************************************************************/
+/*!
+   @brief    Instatiate a GFX 1-bit canvas context with its buffer in a
+             particular kind of memory, see GFXalloc()
+   @param    w      Display width, in pixels
+   @param    h      Display height, in pixels
+   @param    where  Memory to allocate the buffer in
+*/
+/**************************************************************************/
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h, GFXmemory where)
+    : GFXcanvas1(w, h,
+                 (uint8_t *)GFXalloc(((uint32_t)(w + 7) / 8) * h, where)) {
+  buffer_mem = GFXmemoryOf(buffer, where);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Instatiate a GFX 1-bit canvas context with its buffer taken
+             from an arena. The arena, not the canvas, owns the memory.
+   @param    w      Display width, in pixels
+   @param    h      Display height, in pixels
+   @param    arena  Arena to allocate the buffer from
+*/
+/**************************************************************************/
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h, GFXarena &arena)
+    : GFXcanvas1(w, h, (uint8_t *)arena.alloc(((uint32_t)(w + 7) / 8) * h)) {
+  if (buffer)
+    buffer_mem = GFX_MEM_ARENA;
 }
 
 /**************************************************************************/
 /*!
-    @brief  Helper to determine size of a string with current font/size.
-            Pass string and a cursor position, returns UL corner and W,H.
-    @param  str  The ASCII string to measure
-    @param  x    The current cursor X
-    @param  y    The current cursor Y
-    @param  x1   The boundary X coordinate, returned by function
-    @param  y1   The boundary Y coordinate, returned by function
-    @param  w    The boundary width, returned by function
-    @param  h    The boundary height, returned by function
+   @brief    Instatiate a GFX 1-bit canvas context drawing into memory
+             supplied by the caller, e.g. a static array. Nothing is
+             allocated, and the memory is not freed with the canvas.
+   @param    w    Display width, in pixels
+   @param    h    Display height, in pixels
+   @param    buf  At least ((w + 7) / 8) * h bytes of storage
 */
 /**************************************************************************/
-void Adafruit_GFX::getTextBounds(const char *str, int16_t x, int16_t y,
-                                 int16_t *x1, int16_t *y1, uint16_t *w,
-                                 uint16_t *h) {
-
-  uint8_t c; // Current character
-  int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1; // Bound rect
-  // Bound rect is intentionally initialized inverted, so 1st char sets it
-
-  *x1 = x; // Initial position is value passed in
-  *y1 = y;
-  *w = *h = 0; // Initial size is zero
-
-  while ((c = *str++)) {
-    // charBounds() modifies x/y to advance for each character,
-    // and min/max x/y are updated to incrementally build bounding rect.
-    charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
-  }
-
-  if (maxx >= minx) {     // If legit string bounds were found...
-    *x1 = minx;           // Update x1 to least X coord,
-    *w = maxx - minx + 1; // And w to bound rect width
-  }
-  if (maxy >= miny) { // Same for height
-    *y1 = miny;
-    *h = maxy - miny + 1;
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h, uint8_t *buf)
+    : Adafruit_GFX(w, h) {
+  uint32_t bytes = ((uint32_t)(w + 7) / 8) * h;
+  dirty_y1 = 0; // Nothing pushed yet, so everything counts as changed
+  dirty_y2 = h - 1;
+  buffer_mem = buf ? GFX_MEM_CALLER : GFX_MEM_NONE;
+  if ((buffer = buf)) {
+    memset(buffer, 0, bytes);
   }
 }
 
 /**************************************************************************/
 /*!
-    @brief    Helper to determine size of a string with current font/size. Pass
-   string and a cursor position, returns UL corner and W,H.
-    @param    str    The ascii string to measure (as an arduino String() class)
-    @param    x      The current cursor X
-    @param    y      The current cursor Y
-    @param    x1     The boundary X coordinate, set by function
-    @param    y1     The boundary Y coordinate, set by function
-    @param    w      The boundary width, set by function
-    @param    h      The boundary height, set by function
+   @brief    Delete the canvas, free memory
 */
 /**************************************************************************/
-void Adafruit_GFX::getTextBounds(const String &str, int16_t x, int16_t y,
-                                 int16_t *x1, int16_t *y1, uint16_t *w,
-                                 uint16_t *h) {
-  if (str.length() != 0) {
-    getTextBounds(const_cast<char *>(str.c_str()), x, y, x1, y1, w, h);
-  }
+GFXcanvas1::~GFXcanvas1(void) {
+  if (buffer && (buffer_mem <= GFX_MEM_DMA)) // Heap placements only
+    free(buffer);
 }
 
 /**************************************************************************/
 /*!
-    @brief    Helper to determine size of a PROGMEM string with current
-   font/size. Pass string and a cursor position, returns UL corner and W,H.
-    @param    str     The flash-memory ascii string to measure
-    @param    x       The current cursor X
-    @param    y       The current cursor Y
-    @param    x1      The boundary X coordinate, set by function
-    @param    y1      The boundary Y coordinate, set by function
-    @param    w      The boundary width, set by function
-    @param    h      The boundary height, set by function
+    @brief  Draw a pixel to the canvas framebuffer
+    @param  x     x coordinate
+    @param  y     y coordinate
+    @param  color Binary (on or off) color to fill with
 */
 /**************************************************************************/
-void Adafruit_GFX::getTextBounds(const __FlashStringHelper *str, int16_t x,
-                                 int16_t y, int16_t *x1, int16_t *y1,
-                                 uint16_t *w, uint16_t *h) {
-  uint8_t *s = (uint8_t *)str, c;
-
-  *x1 = x;
-  *y1 = y;
-  *w = *h = 0;
+void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (buffer) {
+    if (!clipPixel(&x, &y))
+      return;
 
-  int16_t minx = _width, miny = _height, maxx = -1, maxy = -1;
+    int16_t t;
+    switch (rotation) {
+    case 1:
+      t = x;
+      x = WIDTH - 1 - y;
+      y = t;
+      break;
+    case 2:
+      x = WIDTH - 1 - x;
+      y = HEIGHT - 1 - y;
+      break;
+    case 3:
+      t = x;
+      x = y;
+      y = HEIGHT - 1 - t;
+      break;
+    }
 
-  while ((c = pgm_read_byte(s++)))
-    charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+    markDirty(y, y);
+    uint8_t *ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
+#ifdef __AVR__
+    if (color)
+      *ptr |= pgm_read_byte(&GFXsetBit[x & 7]);
+    else
+      *ptr &= pgm_read_byte(&GFXclrBit[x & 7]);
+#else
+    if (color)
+      *ptr |= 0x80 >> (x & 7);
+    else
+      *ptr &= ~(0x80 >> (x & 7));
+#endif
+  }
+}
 
-  if (maxx >= minx) {
-    *x1 = minx;
-    *w = maxx - minx + 1;
+/**********************************************************************/
+/*!
+        @brief    Get the pixel color value at a given coordinate, relative
+                  to the viewport like drawPixel()
+        @param    x   x coordinate
+        @param    y   y coordinate
+        @returns  The desired pixel's binary color value, either 0x1 (on) or 0x0
+   (off)
+*/
+/**********************************************************************/
+bool GFXcanvas1::getPixel(int16_t x, int16_t y) const {
+  int16_t t;
+  if (!viewPixel(&x, &y))
+    return 0;
+  switch (rotation) {
+  case 1:
+    t = x;
+    x = WIDTH - 1 - y;
+    y = t;
+    break;
+  case 2:
+    x = WIDTH - 1 - x;
+    y = HEIGHT - 1 - y;
+    break;
+  case 3:
+    t = x;
+    x = y;
+    y = HEIGHT - 1 - t;
+    break;
   }
-  if (maxy >= miny) {
-    *y1 = miny;
-    *h = maxy - miny + 1;
+  return getRawPixel(x, y);
+}
+
+/**********************************************************************/
+/*!
+        @brief    Get the pixel color value at a given, unrotated coordinate.
+              This method is intended for hardware drivers to get pixel value
+              in physical coordinates.
+        @param    x   x coordinate
+        @param    y   y coordinate
+        @returns  The desired pixel's binary color value, either 0x1 (on) or 0x0
+   (off)
+*/
+/**********************************************************************/
+bool GFXcanvas1::getRawPixel(int16_t x, int16_t y) const {
+  if ((x < 0) || (y < 0) || (x >= WIDTH) || (y >= HEIGHT))
+    return 0;
+  if (buffer) {
+    uint8_t *ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
+
+#ifdef __AVR__
+    return ((*ptr) & pgm_read_byte(&GFXsetBit[x & 7])) != 0;
+#else
+    return ((*ptr) & (0x80 >> (x & 7))) != 0;
+#endif
   }
+  return 0;
 }
 
 /**************************************************************************/
 /*!
-    @brief      Invert the display (ideally using built-in hardware command)
-    @param   i  True if you want to invert, false to make 'normal'
+   @brief    Flood fill: recolor the area of same-colored pixels around a
+             point, within the clip rectangle. Spans are found a row at a
+             time and filled whole, with no recursion.
+   @param    x      Seed point x coordinate
+   @param    y      Seed point y coordinate
+   @param    color  Binary (on or off) color to fill with
+   @param    work   Buffer for spans still to scan, or NULL to use
+                    GFX_FILL_SPANS entries on the stack. Simple shapes need
+                    a handful; mazes and dithered areas need more.
+   @param    size   Entries in work[]
+   @returns  false if the work buffer ran out, so parts may be unfilled
 */
 /**************************************************************************/
-void Adafruit_GFX::invertDisplay(bool i) {
-  // Do nothing, must be subclassed if supported by hardware
-  (void)i; // disable -Wunused-parameter warning
+bool GFXcanvas1::floodFill(int16_t x, int16_t y, uint16_t color,
+                           GFXfillSpan *work, uint16_t size) {
+  if (!buffer || !clipPixel(&x, &y))
+    return true;
+  GFXrect b = {clip_x0, clip_y0, (int16_t)(clip_x1 - clip_x0),
+               (int16_t)(clip_y1 - clip_y0)};
+  return spanFill(this, &GFXcanvas1::getRawPixel, &GFXcanvas1::drawFastRawHLine,
+                  x, y, (bool)(color != 0), color, b, work, size);
 }
 
-/***************************************************************************/
-
-/**************************************************************************/
+/**********************************************************************/
 /*!
-   @brief    Create a simple drawn button UI element
+        @brief    Get the range of unrotated buffer rows changed by drawing
+              since the canvas was created or clearDirty() was last called.
+              Lets a display driver push only the rows that changed.
+        @param    y1  Set to first changed row
+        @param    y2  Set to last changed row
+        @returns  true if anything changed, false if the canvas is clean
 */
-/**************************************************************************/
-Adafruit_GFX_Button::Adafruit_GFX_Button(void) { _gfx = 0; }
+/**********************************************************************/
+bool GFXcanvas1::getDirtyRows(int16_t *y1, int16_t *y2) const {
+  if (dirty_y2 < dirty_y1)
+    return false;
+  *y1 = (dirty_y1 < 0) ? 0 : dirty_y1;
+  *y2 = (dirty_y2 >= HEIGHT) ? HEIGHT - 1 : dirty_y2;
+  return true;
+}
 
 /**************************************************************************/
 /*!
-   @brief    Initialize button with our desired color/size/settings
-   @param    gfx     Pointer to our display so we can draw to it!
-   @param    x       The X coordinate of the center of the button
-   @param    y       The Y coordinate of the center of the button
-   @param    w       Width of the buttton
-   @param    h       Height of the buttton
-   @param    outline  Color of the outline (16-bit 5-6-5 standard)
-   @param    fill  Color of the button fill (16-bit 5-6-5 standard)
-   @param    textcolor  Color of the button label (16-bit 5-6-5 standard)
-   @param    label  Ascii string of the text inside the button
-   @param    textsize The font magnification of the label text
+    @brief  Fill the framebuffer completely with one color
+    @param  color Binary (on or off) color to fill with
 */
 /**************************************************************************/
-// Classic initButton() function: pass center & size
-void Adafruit_GFX_Button::initButton(Adafruit_GFX *gfx, int16_t x, int16_t y,
-                                     uint16_t w, uint16_t h, uint16_t outline,
-                                     uint16_t fill, uint16_t textcolor,
-                                     char *label, uint8_t textsize) {
-  // Tweak arguments and pass to the newer initButtonUL() function...
-  initButtonUL(gfx, x - (w / 2), y - (h / 2), w, h, outline, fill, textcolor,
-               label, textsize);
+void GFXcanvas1::fillScreen(uint16_t color) {
+  if (clipped()) { // Only the clip rectangle
+    Adafruit_GFX::fillScreen(color);
+    return;
+  }
+  if (buffer) {
+    uint32_t bytes = ((WIDTH + 7) / 8) * HEIGHT;
+    memset(buffer, color ? 0xFF : 0x00, bytes);
+    markDirty(0, HEIGHT - 1);
+  }
 }
 
 /**************************************************************************/
 /*!
-   @brief    Initialize button with our desired color/size/settings
-   @param    gfx     Pointer to our display so we can draw to it!
-   @param    x       The X coordinate of the center of the button
-   @param    y       The Y coordinate of the center of the button
-   @param    w       Width of the buttton
-   @param    h       Height of the buttton
-   @param    outline  Color of the outline (16-bit 5-6-5 standard)
-   @param    fill  Color of the button fill (16-bit 5-6-5 standard)
-   @param    textcolor  Color of the button label (16-bit 5-6-5 standard)
-   @param    label  Ascii string of the text inside the button
-   @param    textsize_x The font magnification in X-axis of the label text
-   @param    textsize_y The font magnification in Y-axis of the label text
+   @brief  Speed optimized vertical line drawing
+   @param  x      Line horizontal start point
+   @param  y      Line vertical start point
+   @param  h      Length of vertical line to be drawn, including first point
+   @param  color  Color to fill with
 */
 /**************************************************************************/
-// Classic initButton() function: pass center & size
-void Adafruit_GFX_Button::initButton(Adafruit_GFX *gfx, int16_t x, int16_t y,
-                                     uint16_t w, uint16_t h, uint16_t outline,
-                                     uint16_t fill, uint16_t textcolor,
-                                     char *label, uint8_t textsize_x,
-                                     uint8_t textsize_y) {
-  // Tweak arguments and pass to the newer initButtonUL() function...
-  initButtonUL(gfx, x - (w / 2), y - (h / 2), w, h, outline, fill, textcolor,
-               label, textsize_x, textsize_y);
+void GFXcanvas1::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                               uint16_t color) {
+
+  if (!clipVLine(&x, &y, &h)) // Off canvas or clip rectangle
+    return;
+
+  if (getRotation() == 0) {
+    drawFastRawVLine(x, y, h, color);
+  } else if (getRotation() == 1) {
+    int16_t t = x;
+    x = WIDTH - 1 - y;
+    y = t;
+    x -= h - 1;
+    drawFastRawHLine(x, y, h, color);
+  } else if (getRotation() == 2) {
+    x = WIDTH - 1 - x;
+    y = HEIGHT - 1 - y;
+
+    y -= h - 1;
+    drawFastRawVLine(x, y, h, color);
+  } else if (getRotation() == 3) {
+    int16_t t = x;
+    x = y;
+    y = HEIGHT - 1 - t;
+    drawFastRawHLine(x, y, h, color);
+  }
 }
 
 /**************************************************************************/
 /*!
-   @brief    Initialize button with our desired color/size/settings, with
-   upper-left coordinates
-   @param    gfx     Pointer to our display so we can draw to it!
-   @param    x1       The X coordinate of the Upper-Left corner of the button
-   @param    y1       The Y coordinate of the Upper-Left corner of the button
-   @param    w       Width of the buttton
-   @param    h       Height of the buttton
-   @param    outline  Color of the outline (16-bit 5-6-5 standard)
-   @param    fill  Color of the button fill (16-bit 5-6-5 standard)
-   @param    textcolor  Color of the button label (16-bit 5-6-5 standard)
-   @param    label  Ascii string of the text inside the button
-   @param    textsize The font magnification of the label text
+   @brief  Speed optimized horizontal line drawing
+   @param  x      Line horizontal start point
+   @param  y      Line vertical start point
+   @param  w      Length of horizontal line to be drawn, including first point
+   @param  color  Color to fill with
 */
 /**************************************************************************/
-void Adafruit_GFX_Button::initButtonUL(Adafruit_GFX *gfx, int16_t x1,
-                                       int16_t y1, uint16_t w, uint16_t h,
-                                       uint16_t outline, uint16_t fill,
-                                       uint16_t textcolor, char *label,
-                                       uint8_t textsize) {
-  initButtonUL(gfx, x1, y1, w, h, outline, fill, textcolor, label, textsize,
-               textsize);
+void GFXcanvas1::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                               uint16_t color) {
+  if (!clipHLine(&x, &y, &w)) // Off canvas or clip rectangle
+    return;
+
+  if (getRotation() == 0) {
+    drawFastRawHLine(x, y, w, color);
+  } else if (getRotation() == 1) {
+    int16_t t = x;
+    x = WIDTH - 1 - y;
+    y = t;
+    drawFastRawVLine(x, y, w, color);
+  } else if (getRotation() == 2) {
+    x = WIDTH - 1 - x;
+    y = HEIGHT - 1 - y;
+
+    x -= w - 1;
+    drawFastRawHLine(x, y, w, color);
+  } else if (getRotation() == 3) {
+    int16_t t = x;
+    x = y;
+    y = HEIGHT - 1 - t;
+    y -= w - 1;
+    drawFastRawVLine(x, y, w, color);
+  }
 }
 
 /**************************************************************************/
 /*!
-   @brief    Initialize button with our desired color/size/settings, with
-   upper-left coordinates
-   @param    gfx     Pointer to our display so we can draw to it!
-   @param    x1       The X coordinate of the Upper-Left corner of the button
-   @param    y1       The Y coordinate of the Upper-Left corner of the button
-   @param    w       Width of the buttton
-   @param    h       Height of the buttton
-   @param    outline  Color of the outline (16-bit 5-6-5 standard)
-   @param    fill  Color of the button fill (16-bit 5-6-5 standard)
-   @param    textcolor  Color of the button label (16-bit 5-6-5 standard)
-   @param    label  Ascii string of the text inside the button
-   @param    textsize_x The font magnification in X-axis of the label text
-   @param    textsize_y The font magnification in Y-axis of the label text
+   @brief    Speed optimized vertical line drawing into the raw canvas buffer
+   @param    x   Line horizontal start point
+   @param    y   Line vertical start point
+   @param    h   length of vertical line to be drawn, including first point
+   @param    color   Binary (on or off) color to fill with
 */
 /**************************************************************************/
-void Adafruit_GFX_Button::initButtonUL(Adafruit_GFX *gfx, int16_t x1,
-                                       int16_t y1, uint16_t w, uint16_t h,
-                                       uint16_t outline, uint16_t fill,
-                                       uint16_t textcolor, char *label,
-                                       uint8_t textsize_x, uint8_t textsize_y) {
-  _x1 = x1;
-  _y1 = y1;
-  _w = w;
-  _h = h;
-  _outlinecolor = outline;
-  _fillcolor = fill;
-  _textcolor = textcolor;
-  _textsize_x = textsize_x;
-  _textsize_y = textsize_y;
-  _gfx = gfx;
-  strncpy(_label, label, 9);
-  _label[9] = 0; // strncpy does not place a null at the end.
-                 // When 'label' is >9 characters, _label is not terminated.
+void GFXcanvas1::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
+                                  uint16_t color) {
+  // x & y already in raw (rotation 0) coordinates, no need to transform.
+  int16_t row_bytes = ((WIDTH + 7) / 8);
+  uint8_t *ptr = &buffer[(x / 8) + y * row_bytes];
+  markDirty(y, y + h - 1);
+
+  if (color > 0) {
+#ifdef __AVR__
+    uint8_t bit_mask = pgm_read_byte(&GFXsetBit[x & 7]);
+#else
+    uint8_t bit_mask = (0x80 >> (x & 7));
+#endif
+    for (; h >= 4; h -= 4) { // Unrolled, stride folded into the offsets
+      ptr[0] |= bit_mask;
+      ptr[row_bytes] |= bit_mask;
+      ptr[2 * row_bytes] |= bit_mask;
+      ptr[3 * row_bytes] |= bit_mask;
+      ptr += 4 * row_bytes;
+    }
+    for (; h > 0; h--) {
+      *ptr |= bit_mask;
+      ptr += row_bytes;
+    }
+  } else {
+#ifdef __AVR__
+    uint8_t bit_mask = pgm_read_byte(&GFXclrBit[x & 7]);
+#else
+    uint8_t bit_mask = ~(0x80 >> (x & 7));
+#endif
+    for (; h >= 4; h -= 4) {
+      ptr[0] &= bit_mask;
+      ptr[row_bytes] &= bit_mask;
+      ptr[2 * row_bytes] &= bit_mask;
+      ptr[3 * row_bytes] &= bit_mask;
+      ptr += 4 * row_bytes;
+    }
+    for (; h > 0; h--) {
+      *ptr &= bit_mask;
+      ptr += row_bytes;
+    }
+  }
 }
 
 /**************************************************************************/
 /*!
-   @brief    Draw the button on the screen
-   @param    inverted Whether to draw with fill/text swapped to indicate
-   'pressed'
+   @brief    Speed optimized horizontal line drawing into the raw canvas buffer
+   @param    x   Line horizontal start point
+   @param    y   Line vertical start point
+   @param    w   length of horizontal line to be drawn, including first point
+   @param    color   Binary (on or off) color to fill with
 */
 /**************************************************************************/
-void Adafruit_GFX_Button::drawButton(bool inverted) {
-  uint16_t fill, outline, text;
+void GFXcanvas1::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
+                                  uint16_t color) {
+  // x & y already in raw (rotation 0) coordinates, no need to transform.
+  if (w <= 0)
+    return;
+  int16_t rowBytes = ((WIDTH + 7) / 8);
+  uint8_t *ptr = &buffer[(x / 8) + y * rowBytes];
+  uint8_t startBit = x & 7;
+  markDirty(y, y);
+
+  // Masks are built whole-byte with one shift each, instead of bit by bit
+  if (startBit + w <= 8) { // Span starts and ends within a single byte
+    uint8_t mask =
+        (uint8_t)(0xFF >> startBit) & (uint8_t)(0xFF << (8 - startBit - w));
+    if (color > 0)
+      *ptr |= mask;
+    else
+      *ptr &= ~mask;
+    return;
+  }
 
-  if (!inverted) {
-    fill = _fillcolor;
-    outline = _outlinecolor;
-    text = _textcolor;
-  } else {
-    fill = _textcolor;
-    outline = _outlinecolor;
-    text = _fillcolor;
+  if (startBit) { // Partial first byte
+    uint8_t startByteBitMask = 0xFF >> startBit;
+    if (color > 0)
+      *ptr |= startByteBitMask;
+    else
+      *ptr &= ~startByteBitMask;
+    ptr++;
+    w -= 8 - startBit;
   }
 
-  uint8_t r = min(_w, _h) / 4; // Corner radius
-  _gfx->fillRoundRect(_x1, _y1, _w, _h, r, fill);
-  _gfx->drawRoundRect(_x1, _y1, _w, _h, r, outline);
+  // Whole bytes in the middle
+  uint16_t wholeBytes = w / 8;
+  fillBytes(ptr, color > 0 ? 0xFF : 0x00, wholeBytes);
 
-  _gfx->setCursor(_x1 + (_w / 2) - (strlen(_label) * 3 * _textsize_x),
-                  _y1 + (_h / 2) - (4 * _textsize_y));
-  _gfx->setTextColor(text);
-  _gfx->setTextSize(_textsize_x, _textsize_y);
-  _gfx->print(_label);
+  uint8_t lastByteBits = w & 7;
+  if (lastByteBits) { // Partial last byte
+    uint8_t lastByteBitMask = (uint8_t)(0xFF << (8 - lastByteBits));
+    ptr += wholeBytes;
+    if (color > 0)
+      *ptr |= lastByteBitMask;
+    else
+      *ptr &= ~lastByteBitMask;
+  }
 }
 
 /**************************************************************************/
 /*!
-    @brief    Helper to let us know if a coordinate is within the bounds of the
-   button
-    @param    x       The X coordinate to check
-    @param    y       The Y coordinate to check
-    @returns  True if within button graphics outline
+   @brief    Instatiate a GFX 4-bit canvas context for graphics
+   @param    w   Display width, in pixels
+   @param    h   Display height, in pixels
 */
 /**************************************************************************/
-bool Adafruit_GFX_Button::contains(int16_t x, int16_t y) {
-  return ((x >= _x1) && (x < (int16_t)(_x1 + _w)) && (y >= _y1) &&
-          (y < (int16_t)(_y1 + _h)));
-}
+GFXcanvas4::GFXcanvas4(uint16_t w, uint16_t h)
+    : GFXcanvas4(w, h, GFX_MEM_ANY) {}
 
 /**************************************************************************/
 /*!
-   @brief    Query whether the button was pressed since we last checked state
-   @returns  True if was not-pressed before, now is.
+   @brief    Instatiate a GFX 4-bit canvas context with its buffer in a
+             particular kind of memory, see GFXalloc()
+   @param    w      Display width, in pixels
+   @param    h      Display height, in pixels
+   @param    where  Memory to allocate the buffer in
 */
 /**************************************************************************/
-bool Adafruit_GFX_Button::justPressed() { return (currstate && !laststate); }
+GFXcanvas4::GFXcanvas4(uint16_t w, uint16_t h, GFXmemory where)
+    : GFXcanvas4(w, h,
+                 (uint8_t *)GFXalloc(((uint32_t)(w + 1) / 2) * h, where)) {
+  buffer_mem = GFXmemoryOf(buffer, where);
+}
 
 /**************************************************************************/
 /*!
-   @brief    Query whether the button was released since we last checked state
-   @returns  True if was pressed before, now is not.
+   @brief    Instatiate a GFX 4-bit canvas context with its buffer taken
+             from an arena. The arena, not the canvas, owns the memory.
+   @param    w      Display width, in pixels
+   @param    h      Display height, in pixels
+   @param    arena  Arena to allocate the buffer from
 */
 /**************************************************************************/
-bool Adafruit_GFX_Button::justReleased() { return (!currstate && laststate); }
-
-// -------------------------------------------------------------------------
-
-// GFXcanvas1, GFXcanvas8 and GFXcanvas16 (currently a WIP, don't get too
-// comfy with the implementation) provide 1-, 8- and 16-bit offscreen
-// canvases, the address of which can be passed to drawBitmap() or
-// pushColors() (the latter appears only in a couple of GFX-subclassed TFT
-// libraries at this time).  This is here mostly to help with the recently-
-// added proportionally-spaced fonts; adds a way to refresh a section of the
-// screen without a massive flickering clear-and-redraw...but maybe you'll
-// find other uses too.  VERY RAM-intensive, since the buffer is in MCU
-// memory and not the display driver...GXFcanvas1 might be minimally useful
-// on an Uno-class board, but this and the others are much more likely to
-// require at least a Mega or various recent ARM-type boards (recommended,
-// as the text+bitmap draw can be pokey).  GFXcanvas1 requires 1 bit per
-// pixel (rounded up to nearest byte per scanline), GFXcanvas8 is 1 byte
-// per pixel (no scanline pad), and GFXcanvas16 uses 2 bytes per pixel (no
-// scanline pad).
-// NOT EXTENSIVELY TESTED YET.  MAY CONTAIN WORST BUGS KNOWN TO HUMANKIND.
-
-#ifdef __AVR__
-// Bitmask tables of 0x80>>X and ~(0x80>>X), because X>>Y is slow on AVR
-const uint8_t PROGMEM GFXcanvas1::GFXsetBit[] = {0x80, 0x40, 0x20, 0x10,
-                                                 0x08, 0x04, 0x02, 0x01};
-const uint8_t PROGMEM GFXcanvas1::GFXclrBit[] = {0x7F, 0xBF, 0xDF, 0xEF,
-                                                 0xF7, 0xFB, 0xFD, 0xFE};
-#endif
+GFXcanvas4::GFXcanvas4(uint16_t w, uint16_t h, GFXarena &arena)
+    : GFXcanvas4(w, h, (uint8_t *)arena.alloc(((uint32_t)(w + 1) / 2) * h)) {
+  if (buffer)
+    buffer_mem = GFX_MEM_ARENA;
+}
 
 /**************************************************************************/
 /*!
-   @brief    Instatiate a GFX 1-bit canvas context for graphics
-   @param    w   Display width, in pixels
-   @param    h   Display height, in pixels
+   @brief    Instatiate a GFX 4-bit canvas context drawing into memory
+             supplied by the caller, e.g. a static array. Nothing is
+             allocated, and the memory is not freed with the canvas.
+   @param    w    Display width, in pixels
+   @param    h    Display height, in pixels
+   @param    buf  At least ((w + 1) / 2) * h bytes of storage
 */
 /**************************************************************************/
-GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
-  uint32_t bytes = ((w + 7) / 8) * h;
-  if ((buffer = (uint8_t *)malloc(bytes))) {
+GFXcanvas4::GFXcanvas4(uint16_t w, uint16_t h, uint8_t *buf)
+    : Adafruit_GFX(w, h) {
+  uint32_t bytes = ((uint32_t)(w + 1) / 2) * h;
+  palette = NULL;
+  buffer_mem = buf ? GFX_MEM_CALLER : GFX_MEM_NONE;
+  if ((buffer = buf)) {
     memset(buffer, 0, bytes);
   }
 }
@@ -1772,22 +3885,23 @@ GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
    @brief    Delete the canvas, free memory
 */
 /**************************************************************************/
-GFXcanvas1::~GFXcanvas1(void) {
-  if (buffer)
+GFXcanvas4::~GFXcanvas4(void) {
+  if (buffer && (buffer_mem <= GFX_MEM_DMA)) // Heap placements only
     free(buffer);
 }
 
 /**************************************************************************/
 /*!
     @brief  Draw a pixel to the canvas framebuffer
-    @param  x     x coordinate
-    @param  y     y coordinate
-    @param  color Binary (on or off) color to fill with
+    @param  x   x coordinate
+    @param  y   y coordinate
+    @param  color 4-bit palette index to fill with. Only lower nibble of
+                  uint16_t is used.
 */
 /**************************************************************************/
-void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
+void GFXcanvas4::drawPixel(int16_t x, int16_t y, uint16_t color) {
   if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    if (!clipPixel(&x, &y))
       return;
 
     int16_t t;
@@ -1808,32 +3922,27 @@ void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
       break;
     }
 
-    uint8_t *ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
-#ifdef __AVR__
-    if (color)
-      *ptr |= pgm_read_byte(&GFXsetBit[x & 7]);
-    else
-      *ptr &= pgm_read_byte(&GFXclrBit[x & 7]);
-#else
-    if (color)
-      *ptr |= 0x80 >> (x & 7);
+    uint8_t *ptr = &buffer[(x / 2) + y * ((WIDTH + 1) / 2)];
+    if (x & 1)
+      *ptr = (*ptr & 0xF0) | (color & 0x0F);
     else
-      *ptr &= ~(0x80 >> (x & 7));
-#endif
+      *ptr = (*ptr & 0x0F) | (color << 4);
   }
 }
 
 /**********************************************************************/
 /*!
-        @brief    Get the pixel color value at a given coordinate
+        @brief    Get the pixel color value at a given coordinate, relative
+                  to the viewport like drawPixel()
         @param    x   x coordinate
         @param    y   y coordinate
-        @returns  The desired pixel's binary color value, either 0x1 (on) or 0x0
-   (off)
+        @returns  The desired pixel's 4-bit palette index
 */
 /**********************************************************************/
-bool GFXcanvas1::getPixel(int16_t x, int16_t y) const {
+uint8_t GFXcanvas4::getPixel(int16_t x, int16_t y) const {
   int16_t t;
+  if (!viewPixel(&x, &y))
+    return 0;
   switch (rotation) {
   case 1:
     t = x;
@@ -1860,35 +3969,58 @@ bool GFXcanvas1::getPixel(int16_t x, int16_t y) const {
               in physical coordinates.
         @param    x   x coordinate
         @param    y   y coordinate
-        @returns  The desired pixel's binary color value, either 0x1 (on) or 0x0
-   (off)
+        @returns  The desired pixel's 4-bit palette index
 */
 /**********************************************************************/
-bool GFXcanvas1::getRawPixel(int16_t x, int16_t y) const {
+uint8_t GFXcanvas4::getRawPixel(int16_t x, int16_t y) const {
   if ((x < 0) || (y < 0) || (x >= WIDTH) || (y >= HEIGHT))
     return 0;
   if (buffer) {
-    uint8_t *ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
-
-#ifdef __AVR__
-    return ((*ptr) & pgm_read_byte(&GFXsetBit[x & 7])) != 0;
-#else
-    return ((*ptr) & (0x80 >> (x & 7))) != 0;
-#endif
+    uint8_t b = buffer[(x / 2) + y * ((WIDTH + 1) / 2)];
+    return (x & 1) ? (b & 0x0F) : (b >> 4);
   }
   return 0;
 }
 
+/**************************************************************************/
+/*!
+   @brief    Flood fill: recolor the area of same-colored pixels around a
+             point, within the clip rectangle. Spans are found a row at a
+             time and filled whole, with no recursion.
+   @param    x      Seed point x coordinate
+   @param    y      Seed point y coordinate
+   @param    color  4-bit palette index to fill with
+   @param    work   Buffer for spans still to scan, or NULL to use
+                    GFX_FILL_SPANS entries on the stack. Simple shapes need
+                    a handful; mazes and dithered areas need more.
+   @param    size   Entries in work[]
+   @returns  false if the work buffer ran out, so parts may be unfilled
+*/
+/**************************************************************************/
+bool GFXcanvas4::floodFill(int16_t x, int16_t y, uint16_t color,
+                           GFXfillSpan *work, uint16_t size) {
+  if (!buffer || !clipPixel(&x, &y))
+    return true;
+  GFXrect b = {clip_x0, clip_y0, (int16_t)(clip_x1 - clip_x0),
+               (int16_t)(clip_y1 - clip_y0)};
+  return spanFill(this, &GFXcanvas4::getRawPixel, &GFXcanvas4::drawFastRawHLine,
+                  x, y, (uint8_t)(color & 0x0F), color, b, work, size);
+}
+
 /**************************************************************************/
 /*!
     @brief  Fill the framebuffer completely with one color
-    @param  color Binary (on or off) color to fill with
+    @param  color 4-bit palette index to fill with. Only lower nibble of
+                  uint16_t is used.
 */
 /**************************************************************************/
-void GFXcanvas1::fillScreen(uint16_t color) {
-  if (buffer) {
-    uint32_t bytes = ((WIDTH + 7) / 8) * HEIGHT;
-    memset(buffer, color ? 0xFF : 0x00, bytes);
+void GFXcanvas4::fillScreen(uint16_t color) {
+  if (clipped()) { // Only the clip rectangle
+    Adafruit_GFX::fillScreen(color);
+    return;
+  }
+  if (buffer) {
+    memset(buffer, (color & 0x0F) * 0x11, ((WIDTH + 1) / 2) * HEIGHT);
   }
 }
 
@@ -1898,33 +4030,14 @@ void GFXcanvas1::fillScreen(uint16_t color) {
    @param  x      Line horizontal start point
    @param  y      Line vertical start point
    @param  h      Length of vertical line to be drawn, including first point
-   @param  color  Color to fill with
+   @param  color  4-bit palette index to fill with. Only lower nibble of
+                  uint16_t is used.
 */
 /**************************************************************************/
-void GFXcanvas1::drawFastVLine(int16_t x, int16_t y, int16_t h,
+void GFXcanvas4::drawFastVLine(int16_t x, int16_t y, int16_t h,
                                uint16_t color) {
-
-  if (h < 0) { // Convert negative heights to positive equivalent
-    h *= -1;
-    y -= h - 1;
-    if (y < 0) {
-      h += y;
-      y = 0;
-    }
-  }
-
-  // Edge rejection (no-draw if totally off canvas)
-  if ((x < 0) || (x >= width()) || (y >= height()) || ((y + h - 1) < 0)) {
+  if (!clipVLine(&x, &y, &h)) // Off canvas or clip rectangle
     return;
-  }
-
-  if (y < 0) { // Clip top
-    h += y;
-    y = 0;
-  }
-  if (y + h > height()) { // Clip bottom
-    h = height() - y;
-  }
 
   if (getRotation() == 0) {
     drawFastRawVLine(x, y, h, color);
@@ -1953,33 +4066,16 @@ void GFXcanvas1::drawFastVLine(int16_t x, int16_t y, int16_t h,
    @brief  Speed optimized horizontal line drawing
    @param  x      Line horizontal start point
    @param  y      Line vertical start point
-   @param  w      Length of horizontal line to be drawn, including first point
-   @param  color  Color to fill with
+   @param  w      Length of horizontal line to be drawn, including 1st point
+   @param  color  4-bit palette index to fill with. Only lower nibble of
+                  uint16_t is used.
 */
 /**************************************************************************/
-void GFXcanvas1::drawFastHLine(int16_t x, int16_t y, int16_t w,
+void GFXcanvas4::drawFastHLine(int16_t x, int16_t y, int16_t w,
                                uint16_t color) {
-  if (w < 0) { // Convert negative widths to positive equivalent
-    w *= -1;
-    x -= w - 1;
-    if (x < 0) {
-      w += x;
-      x = 0;
-    }
-  }
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((y < 0) || (y >= height()) || (x >= width()) || ((x + w - 1) < 0)) {
+  if (!clipHLine(&x, &y, &w)) // Off canvas or clip rectangle
     return;
-  }
-
-  if (x < 0) { // Clip left
-    w += x;
-    x = 0;
-  }
-  if (x + w >= width()) { // Clip right
-    w = width() - x;
-  }
 
   if (getRotation() == 0) {
     drawFastRawHLine(x, y, w, color);
@@ -2009,35 +4105,34 @@ void GFXcanvas1::drawFastHLine(int16_t x, int16_t y, int16_t w,
    @param    x   Line horizontal start point
    @param    y   Line vertical start point
    @param    h   length of vertical line to be drawn, including first point
-   @param    color   Binary (on or off) color to fill with
+   @param    color   4-bit palette index to fill with. Only lower nibble of
+   uint16_t is used.
 */
 /**************************************************************************/
-void GFXcanvas1::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
+void GFXcanvas4::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
                                   uint16_t color) {
   // x & y already in raw (rotation 0) coordinates, no need to transform.
-  int16_t row_bytes = ((WIDTH + 7) / 8);
-  uint8_t *ptr = &buffer[(x / 8) + y * row_bytes];
-
-  if (color > 0) {
-#ifdef __AVR__
-    uint8_t bit_mask = pgm_read_byte(&GFXsetBit[x & 7]);
-#else
-    uint8_t bit_mask = (0x80 >> (x & 7));
-#endif
-    for (int16_t i = 0; i < h; i++) {
-      *ptr |= bit_mask;
-      ptr += row_bytes;
-    }
+  int16_t row_bytes = ((WIDTH + 1) / 2);
+  uint8_t *ptr = &buffer[(x / 2) + y * row_bytes];
+  // Same nibble of every byte in the column, so pick mask & value once
+  uint8_t keep_mask, nibble;
+  if (x & 1) {
+    keep_mask = 0xF0;
+    nibble = color & 0x0F;
   } else {
-#ifdef __AVR__
-    uint8_t bit_mask = pgm_read_byte(&GFXclrBit[x & 7]);
-#else
-    uint8_t bit_mask = ~(0x80 >> (x & 7));
-#endif
-    for (int16_t i = 0; i < h; i++) {
-      *ptr &= bit_mask;
-      ptr += row_bytes;
-    }
+    keep_mask = 0x0F;
+    nibble = color << 4;
+  }
+  for (; h >= 4; h -= 4) { // Unrolled, stride folded into the offsets
+    ptr[0] = (ptr[0] & keep_mask) | nibble;
+    ptr[row_bytes] = (ptr[row_bytes] & keep_mask) | nibble;
+    ptr[2 * row_bytes] = (ptr[2 * row_bytes] & keep_mask) | nibble;
+    ptr[3 * row_bytes] = (ptr[3 * row_bytes] & keep_mask) | nibble;
+    ptr += 4 * row_bytes;
+  }
+  for (; h > 0; h--) {
+    *ptr = (*ptr & keep_mask) | nibble;
+    ptr += row_bytes;
   }
 }
 
@@ -2047,62 +4142,29 @@ void GFXcanvas1::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
    @param    x   Line horizontal start point
    @param    y   Line vertical start point
    @param    w   length of horizontal line to be drawn, including first point
-   @param    color   Binary (on or off) color to fill with
+   @param    color   4-bit palette index to fill with. Only lower nibble of
+   uint16_t is used.
 */
 /**************************************************************************/
-void GFXcanvas1::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
+void GFXcanvas4::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
                                   uint16_t color) {
   // x & y already in raw (rotation 0) coordinates, no need to transform.
-  int16_t rowBytes = ((WIDTH + 7) / 8);
-  uint8_t *ptr = &buffer[(x / 8) + y * rowBytes];
-  size_t remainingWidthBits = w;
-
-  // check to see if first byte needs to be partially filled
-  if ((x & 7) > 0) {
-    // create bit mask for first byte
-    uint8_t startByteBitMask = 0x00;
-    for (int8_t i = (x & 7); ((i < 8) && (remainingWidthBits > 0)); i++) {
-#ifdef __AVR__
-      startByteBitMask |= pgm_read_byte(&GFXsetBit[i]);
-#else
-      startByteBitMask |= (0x80 >> i);
-#endif
-      remainingWidthBits--;
-    }
-    if (color > 0) {
-      *ptr |= startByteBitMask;
-    } else {
-      *ptr &= ~startByteBitMask;
-    }
+  if (w <= 0)
+    return;
+  uint8_t c = color & 0x0F;
+  uint8_t *ptr = &buffer[(x / 2) + y * ((WIDTH + 1) / 2)];
 
+  if (x & 1) { // Partial first byte, low nibble only
+    *ptr = (*ptr & 0xF0) | c;
     ptr++;
+    w--;
   }
-
-  // do the next remainingWidthBits bits
-  if (remainingWidthBits > 0) {
-    size_t remainingWholeBytes = remainingWidthBits / 8;
-    size_t lastByteBits = remainingWidthBits % 8;
-    uint8_t wholeByteColor = color > 0 ? 0xFF : 0x00;
-
-    memset(ptr, wholeByteColor, remainingWholeBytes);
-
-    if (lastByteBits > 0) {
-      uint8_t lastByteBitMask = 0x00;
-      for (size_t i = 0; i < lastByteBits; i++) {
-#ifdef __AVR__
-        lastByteBitMask |= pgm_read_byte(&GFXsetBit[i]);
-#else
-        lastByteBitMask |= (0x80 >> i);
-#endif
-      }
-      ptr += remainingWholeBytes;
-
-      if (color > 0) {
-        *ptr |= lastByteBitMask;
-      } else {
-        *ptr &= ~lastByteBitMask;
-      }
-    }
+  // Whole bytes (two pixels each) in the middle
+  int16_t wholeBytes = w / 2;
+  fillBytes(ptr, c * 0x11, wholeBytes);
+  if (w & 1) { // Partial last byte, high nibble only
+    ptr += wholeBytes;
+    *ptr = (*ptr & 0x0F) | (c << 4);
   }
 }
 
@@ -2113,9 +4175,57 @@ void GFXcanvas1::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
    @param    h   Display height, in pixels
 */
 /**************************************************************************/
-GFXcanvas8::GFXcanvas8(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
-  uint32_t bytes = w * h;
-  if ((buffer = (uint8_t *)malloc(bytes))) {
+GFXcanvas8::GFXcanvas8(uint16_t w, uint16_t h)
+    : GFXcanvas8(w, h, GFX_MEM_ANY) {}
+
+/**************************************************************************/
+/*!
+   @brief    Instatiate a GFX 8-bit canvas context with its buffer in a
+             particular kind of memory, see GFXalloc()
+   @param    w      Display width, in pixels
+   @param    h      Display height, in pixels
+   @param    where  Memory to allocate the buffer in
+*/
+/**************************************************************************/
+GFXcanvas8::GFXcanvas8(uint16_t w, uint16_t h, GFXmemory where)
+    : GFXcanvas8(w, h, (uint8_t *)GFXalloc((uint32_t)w * h, where)) {
+  buffer_mem = GFXmemoryOf(buffer, where);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Instatiate a GFX 8-bit canvas context with its buffer taken
+             from an arena. The arena, not the canvas, owns the memory.
+   @param    w      Display width, in pixels
+   @param    h      Display height, in pixels
+   @param    arena  Arena to allocate the buffer from
+*/
+/**************************************************************************/
+GFXcanvas8::GFXcanvas8(uint16_t w, uint16_t h, GFXarena &arena)
+    : GFXcanvas8(w, h, (uint8_t *)arena.alloc((uint32_t)w * h)) {
+  if (buffer)
+    buffer_mem = GFX_MEM_ARENA;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Instatiate a GFX 8-bit canvas context drawing into memory
+             supplied by the caller, e.g. a static array. Nothing is
+             allocated, and the memory is not freed with the canvas.
+   @param    w    Display width, in pixels
+   @param    h    Display height, in pixels
+   @param    buf  At least w * h bytes of storage
+*/
+/**************************************************************************/
+GFXcanvas8::GFXcanvas8(uint16_t w, uint16_t h, uint8_t *buf)
+    : Adafruit_GFX(w, h) {
+  uint32_t bytes = (uint32_t)w * h;
+  pixel_origin = 0; // Rotation 0
+  x_step = 1;
+  y_step = w;
+  palette = NULL;
+  buffer_mem = buf ? GFX_MEM_CALLER : GFX_MEM_NONE;
+  if ((buffer = buf)) {
     memset(buffer, 0, bytes);
   }
 }
@@ -2126,7 +4236,7 @@ GFXcanvas8::GFXcanvas8(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
 */
 /**************************************************************************/
 GFXcanvas8::~GFXcanvas8(void) {
-  if (buffer)
+  if (buffer && (buffer_mem <= GFX_MEM_DMA)) // Heap placements only
     free(buffer);
 }
 
@@ -2139,59 +4249,97 @@ GFXcanvas8::~GFXcanvas8(void) {
 */
 /**************************************************************************/
 void GFXcanvas8::drawPixel(int16_t x, int16_t y, uint16_t color) {
-  if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
-      return;
-
-    int16_t t;
-    switch (rotation) {
-    case 1:
-      t = x;
-      x = WIDTH - 1 - y;
-      y = t;
-      break;
-    case 2:
-      x = WIDTH - 1 - x;
-      y = HEIGHT - 1 - y;
-      break;
-    case 3:
-      t = x;
-      x = y;
-      y = HEIGHT - 1 - t;
-      break;
-    }
-
-    buffer[x + y * WIDTH] = color;
+  // clipPixel() rejects off-canvas and clipped coordinates with unsigned
+  // compares; rotation is already folded into pixel_origin / x_step / y_step.
+  if (buffer && clipPixel(&x, &y)) {
+    buffer[pixel_origin + x * x_step + y * y_step] = color;
   }
 }
 
 /**********************************************************************/
 /*!
-        @brief    Get the pixel color value at a given coordinate
+        @brief    Get the pixel color value at a given coordinate, relative
+                  to the viewport like drawPixel()
         @param    x   x coordinate
         @param    y   y coordinate
         @returns  The desired pixel's 8-bit color value
 */
 /**********************************************************************/
 uint8_t GFXcanvas8::getPixel(int16_t x, int16_t y) const {
-  int16_t t;
+  if (buffer && viewPixel(&x, &y)) {
+    return buffer[pixel_origin + x * x_step + y * y_step];
+  }
+  return 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set rotation setting for the canvas, and precompute where
+            rotated (0,0) lands in the buffer and how far one step in
+            rotated X or Y moves through it. Pixel access then needs no
+            per-call rotation switch.
+    @param  x   0 thru 3 corresponding to 4 cardinal rotations
+*/
+/**************************************************************************/
+void GFXcanvas8::setRotation(uint8_t x) {
+  Adafruit_GFX::setRotation(x);
   switch (rotation) {
-  case 1:
-    t = x;
-    x = WIDTH - 1 - y;
-    y = t;
+  case 0:
+    pixel_origin = 0;
+    x_step = 1;
+    y_step = WIDTH;
+    break;
+  case 1: // Rotated X runs down raw columns, Y runs right to left
+    pixel_origin = WIDTH - 1;
+    x_step = WIDTH;
+    y_step = -1;
     break;
   case 2:
-    x = WIDTH - 1 - x;
-    y = HEIGHT - 1 - y;
+    pixel_origin = (int32_t)(HEIGHT - 1) * WIDTH + (WIDTH - 1);
+    x_step = -1;
+    y_step = -WIDTH;
     break;
-  case 3:
-    t = x;
-    x = y;
-    y = HEIGHT - 1 - t;
+  case 3: // Rotated X runs up raw columns, Y runs left to right
+    pixel_origin = (int32_t)(HEIGHT - 1) * WIDTH;
+    x_step = -WIDTH;
+    y_step = 1;
     break;
   }
-  return getRawPixel(x, y);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Fill a clipped run of pixels starting at a buffer index and
+             advancing by a fixed step, i.e. a line in any rotation. Runs
+             that end up contiguous in memory use the word-wide kernel.
+   @param    index   Buffer index of the first pixel
+   @param    step    Buffer index increment between pixels
+   @param    n       Number of pixels, already clipped to the canvas
+   @param    color   8-bit Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas8::drawSpan(int32_t index, int32_t step, int16_t n,
+                          uint16_t color) {
+  if (n <= 0)
+    return;
+  uint8_t *ptr = buffer + index;
+  if (step == 1) {
+    fillBytes(ptr, color, n);
+  } else if (step == -1) {
+    fillBytes(ptr - (n - 1), color, n);
+  } else {
+    for (; n >= 4; n -= 4) { // Unrolled, stride folded into the offsets
+      ptr[0] = color;
+      ptr[step] = color;
+      ptr[2 * step] = color;
+      ptr[3 * step] = color;
+      ptr += 4 * step;
+    }
+    for (; n > 0; n--) {
+      *ptr = color;
+      ptr += step;
+    }
+  }
 }
 
 /**********************************************************************/
@@ -2213,6 +4361,31 @@ uint8_t GFXcanvas8::getRawPixel(int16_t x, int16_t y) const {
   return 0;
 }
 
+/**************************************************************************/
+/*!
+   @brief    Flood fill: recolor the area of same-colored pixels around a
+             point, within the clip rectangle. Spans are found a row at a
+             time and filled whole, with no recursion.
+   @param    x      Seed point x coordinate
+   @param    y      Seed point y coordinate
+   @param    color  8-bit color to fill with
+   @param    work   Buffer for spans still to scan, or NULL to use
+                    GFX_FILL_SPANS entries on the stack. Simple shapes need
+                    a handful; mazes and dithered areas need more.
+   @param    size   Entries in work[]
+   @returns  false if the work buffer ran out, so parts may be unfilled
+*/
+/**************************************************************************/
+bool GFXcanvas8::floodFill(int16_t x, int16_t y, uint16_t color,
+                           GFXfillSpan *work, uint16_t size) {
+  if (!buffer || !clipPixel(&x, &y))
+    return true;
+  GFXrect b = {clip_x0, clip_y0, (int16_t)(clip_x1 - clip_x0),
+               (int16_t)(clip_y1 - clip_y0)};
+  return spanFill(this, &GFXcanvas8::getRawPixel, &GFXcanvas8::drawFastRawHLine,
+                  x, y, (uint8_t)color, color, b, work, size);
+}
+
 /**************************************************************************/
 /*!
     @brief  Fill the framebuffer completely with one color
@@ -2220,6 +4393,10 @@ uint8_t GFXcanvas8::getRawPixel(int16_t x, int16_t y) const {
 */
 /**************************************************************************/
 void GFXcanvas8::fillScreen(uint16_t color) {
+  if (clipped()) { // Only the clip rectangle
+    Adafruit_GFX::fillScreen(color);
+    return;
+  }
   if (buffer) {
     memset(buffer, color, WIDTH * HEIGHT);
   }
@@ -2237,47 +4414,11 @@ void GFXcanvas8::fillScreen(uint16_t color) {
 /**************************************************************************/
 void GFXcanvas8::drawFastVLine(int16_t x, int16_t y, int16_t h,
                                uint16_t color) {
-  if (h < 0) { // Convert negative heights to positive equivalent
-    h *= -1;
-    y -= h - 1;
-    if (y < 0) {
-      h += y;
-      y = 0;
-    }
-  }
-
-  // Edge rejection (no-draw if totally off canvas)
-  if ((x < 0) || (x >= width()) || (y >= height()) || ((y + h - 1) < 0)) {
+  if (!clipVLine(&x, &y, &h)) // Off canvas or clip rectangle
     return;
-  }
-
-  if (y < 0) { // Clip top
-    h += y;
-    y = 0;
-  }
-  if (y + h > height()) { // Clip bottom
-    h = height() - y;
-  }
-
-  if (getRotation() == 0) {
-    drawFastRawVLine(x, y, h, color);
-  } else if (getRotation() == 1) {
-    int16_t t = x;
-    x = WIDTH - 1 - y;
-    y = t;
-    x -= h - 1;
-    drawFastRawHLine(x, y, h, color);
-  } else if (getRotation() == 2) {
-    x = WIDTH - 1 - x;
-    y = HEIGHT - 1 - y;
 
-    y -= h - 1;
-    drawFastRawVLine(x, y, h, color);
-  } else if (getRotation() == 3) {
-    int16_t t = x;
-    x = y;
-    y = HEIGHT - 1 - t;
-    drawFastRawHLine(x, y, h, color);
+  if (buffer) {
+    drawSpan(pixel_origin + x * x_step + y * y_step, y_step, h, color);
   }
 }
 
@@ -2294,47 +4435,11 @@ void GFXcanvas8::drawFastVLine(int16_t x, int16_t y, int16_t h,
 void GFXcanvas8::drawFastHLine(int16_t x, int16_t y, int16_t w,
                                uint16_t color) {
 
-  if (w < 0) { // Convert negative widths to positive equivalent
-    w *= -1;
-    x -= w - 1;
-    if (x < 0) {
-      w += x;
-      x = 0;
-    }
-  }
-
-  // Edge rejection (no-draw if totally off canvas)
-  if ((y < 0) || (y >= height()) || (x >= width()) || ((x + w - 1) < 0)) {
+  if (!clipHLine(&x, &y, &w)) // Off canvas or clip rectangle
     return;
-  }
-
-  if (x < 0) { // Clip left
-    w += x;
-    x = 0;
-  }
-  if (x + w >= width()) { // Clip right
-    w = width() - x;
-  }
-
-  if (getRotation() == 0) {
-    drawFastRawHLine(x, y, w, color);
-  } else if (getRotation() == 1) {
-    int16_t t = x;
-    x = WIDTH - 1 - y;
-    y = t;
-    drawFastRawVLine(x, y, w, color);
-  } else if (getRotation() == 2) {
-    x = WIDTH - 1 - x;
-    y = HEIGHT - 1 - y;
 
-    x -= w - 1;
-    drawFastRawHLine(x, y, w, color);
-  } else if (getRotation() == 3) {
-    int16_t t = x;
-    x = y;
-    y = HEIGHT - 1 - t;
-    y -= w - 1;
-    drawFastRawVLine(x, y, w, color);
+  if (buffer) {
+    drawSpan(pixel_origin + x * x_step + y * y_step, x_step, w, color);
   }
 }
 
@@ -2352,9 +4457,17 @@ void GFXcanvas8::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
                                   uint16_t color) {
   // x & y already in raw (rotation 0) coordinates, no need to transform.
   uint8_t *buffer_ptr = buffer + y * WIDTH + x;
-  for (int16_t i = 0; i < h; i++) {
+  const int32_t stride = WIDTH;
+  for (; h >= 4; h -= 4) { // Unrolled, stride folded into the offsets
+    buffer_ptr[0] = color;
+    buffer_ptr[stride] = color;
+    buffer_ptr[2 * stride] = color;
+    buffer_ptr[3 * stride] = color;
+    buffer_ptr += 4 * stride;
+  }
+  for (; h > 0; h--) {
     (*buffer_ptr) = color;
-    buffer_ptr += WIDTH;
+    buffer_ptr += stride;
   }
 }
 
@@ -2371,7 +4484,9 @@ void GFXcanvas8::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
 void GFXcanvas8::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
                                   uint16_t color) {
   // x & y already in raw (rotation 0) coordinates, no need to transform.
-  memset(buffer + y * WIDTH + x, color, w);
+  // Inline word fill; most spans are too short to amortize a memset call
+  if (w > 0)
+    fillBytes(buffer + y * WIDTH + x, color, w);
 }
 
 /**************************************************************************/
@@ -2381,9 +4496,57 @@ void GFXcanvas8::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
    @param    h   Display height, in pixels
 */
 /**************************************************************************/
-GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
-  uint32_t bytes = w * h * 2;
-  if ((buffer = (uint16_t *)malloc(bytes))) {
+GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h)
+    : GFXcanvas16(w, h, GFX_MEM_ANY) {}
+
+/**************************************************************************/
+/*!
+   @brief    Instatiate a GFX 16-bit canvas context with its buffer in a
+             particular kind of memory, see GFXalloc()
+   @param    w      Display width, in pixels
+   @param    h      Display height, in pixels
+   @param    where  Memory to allocate the buffer in
+*/
+/**************************************************************************/
+GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h, GFXmemory where)
+    : GFXcanvas16(w, h, (uint16_t *)GFXalloc((uint32_t)w * h * 2, where)) {
+  buffer_mem = GFXmemoryOf(buffer, where);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Instatiate a GFX 16-bit canvas context with its buffer taken
+             from an arena. The arena, not the canvas, owns the memory.
+   @param    w      Display width, in pixels
+   @param    h      Display height, in pixels
+   @param    arena  Arena to allocate the buffer from
+*/
+/**************************************************************************/
+GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h, GFXarena &arena)
+    : GFXcanvas16(w, h, (uint16_t *)arena.alloc((uint32_t)w * h * 2)) {
+  if (buffer)
+    buffer_mem = GFX_MEM_ARENA;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Instatiate a GFX 16-bit canvas context drawing into memory
+             supplied by the caller, e.g. a static array. Nothing is
+             allocated, and the memory is not freed with the canvas.
+   @param    w    Display width, in pixels
+   @param    h    Display height, in pixels
+   @param    buf  At least w * h * 2 bytes of storage, 16-bit aligned
+*/
+/**************************************************************************/
+GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h, uint16_t *buf)
+    : Adafruit_GFX(w, h) {
+  uint32_t bytes = (uint32_t)w * h * 2;
+  pixel_origin = 0; // Rotation 0
+  x_step = 1;
+  y_step = w;
+  big_endian = false;
+  buffer_mem = buf ? GFX_MEM_CALLER : GFX_MEM_NONE;
+  if ((buffer = buf)) {
     memset(buffer, 0, bytes);
   }
 }
@@ -2394,7 +4557,7 @@ GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
 */
 /**************************************************************************/
 GFXcanvas16::~GFXcanvas16(void) {
-  if (buffer)
+  if (buffer && (buffer_mem <= GFX_MEM_DMA)) // Heap placements only
     free(buffer);
 }
 
@@ -2402,64 +4565,103 @@ GFXcanvas16::~GFXcanvas16(void) {
 /*!
     @brief  Draw a pixel to the canvas framebuffer
     @param  x   x coordinate
-    @param  y   y coordinate
-    @param  color 16-bit 5-6-5 Color to fill with
-*/
-/**************************************************************************/
-void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
-  if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
-      return;
-
-    int16_t t;
-    switch (rotation) {
-    case 1:
-      t = x;
-      x = WIDTH - 1 - y;
-      y = t;
-      break;
-    case 2:
-      x = WIDTH - 1 - x;
-      y = HEIGHT - 1 - y;
-      break;
-    case 3:
-      t = x;
-      x = y;
-      y = HEIGHT - 1 - t;
-      break;
-    }
-
-    buffer[x + y * WIDTH] = color;
+    @param  y   y coordinate
+    @param  color 16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  // clipPixel() rejects off-canvas and clipped coordinates with unsigned
+  // compares; rotation is already folded into pixel_origin / x_step / y_step.
+  if (buffer && clipPixel(&x, &y)) {
+    buffer[pixel_origin + x * x_step + y * y_step] = toStorage(color);
   }
 }
 
 /**********************************************************************/
 /*!
-        @brief    Get the pixel color value at a given coordinate
+        @brief    Get the pixel color value at a given coordinate, relative
+                  to the viewport like drawPixel()
         @param    x   x coordinate
         @param    y   y coordinate
         @returns  The desired pixel's 16-bit 5-6-5 color value
 */
 /**********************************************************************/
 uint16_t GFXcanvas16::getPixel(int16_t x, int16_t y) const {
-  int16_t t;
+  if (buffer && viewPixel(&x, &y)) {
+    return toStorage(buffer[pixel_origin + x * x_step + y * y_step]);
+  }
+  return 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set rotation setting for the canvas, and precompute where
+            rotated (0,0) lands in the buffer and how far one step in
+            rotated X or Y moves through it. Pixel access then needs no
+            per-call rotation switch.
+    @param  x   0 thru 3 corresponding to 4 cardinal rotations
+*/
+/**************************************************************************/
+void GFXcanvas16::setRotation(uint8_t x) {
+  Adafruit_GFX::setRotation(x);
   switch (rotation) {
-  case 1:
-    t = x;
-    x = WIDTH - 1 - y;
-    y = t;
+  case 0:
+    pixel_origin = 0;
+    x_step = 1;
+    y_step = WIDTH;
+    break;
+  case 1: // Rotated X runs down raw columns, Y runs right to left
+    pixel_origin = WIDTH - 1;
+    x_step = WIDTH;
+    y_step = -1;
     break;
   case 2:
-    x = WIDTH - 1 - x;
-    y = HEIGHT - 1 - y;
+    pixel_origin = (int32_t)(HEIGHT - 1) * WIDTH + (WIDTH - 1);
+    x_step = -1;
+    y_step = -WIDTH;
     break;
-  case 3:
-    t = x;
-    x = y;
-    y = HEIGHT - 1 - t;
+  case 3: // Rotated X runs up raw columns, Y runs left to right
+    pixel_origin = (int32_t)(HEIGHT - 1) * WIDTH;
+    x_step = -WIDTH;
+    y_step = 1;
     break;
   }
-  return getRawPixel(x, y);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Fill a clipped run of pixels starting at a buffer index and
+             advancing by a fixed step, i.e. a line in any rotation. Runs
+             that end up contiguous in memory use the word-wide kernel.
+   @param    index   Buffer index of the first pixel
+   @param    step    Buffer index increment between pixels
+   @param    n       Number of pixels, already clipped to the canvas
+   @param    color   16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::drawSpan(int32_t index, int32_t step, int16_t n,
+                           uint16_t color) {
+  if (n <= 0)
+    return;
+  color = toStorage(color); // Once per span, not per pixel
+  uint16_t *ptr = buffer + index;
+  if (step == 1) {
+    fillWords(ptr, color, n);
+  } else if (step == -1) {
+    fillWords(ptr - (n - 1), color, n);
+  } else {
+    for (; n >= 4; n -= 4) { // Unrolled, stride folded into the offsets
+      ptr[0] = color;
+      ptr[step] = color;
+      ptr[2 * step] = color;
+      ptr[3 * step] = color;
+      ptr += 4 * step;
+    }
+    for (; n > 0; n--) {
+      *ptr = color;
+      ptr += step;
+    }
+  }
 }
 
 /**********************************************************************/
@@ -2476,11 +4678,37 @@ uint16_t GFXcanvas16::getRawPixel(int16_t x, int16_t y) const {
   if ((x < 0) || (y < 0) || (x >= WIDTH) || (y >= HEIGHT))
     return 0;
   if (buffer) {
-    return buffer[x + y * WIDTH];
+    return toStorage(buffer[x + y * WIDTH]);
   }
   return 0;
 }
 
+/**************************************************************************/
+/*!
+   @brief    Flood fill: recolor the area of same-colored pixels around a
+             point, within the clip rectangle. Spans are found a row at a
+             time and filled whole, with no recursion.
+   @param    x      Seed point x coordinate
+   @param    y      Seed point y coordinate
+   @param    color  16-bit 5-6-5 Color to fill with
+   @param    work   Buffer for spans still to scan, or NULL to use
+                    GFX_FILL_SPANS entries on the stack. Simple shapes need
+                    a handful; mazes and dithered areas need more.
+   @param    size   Entries in work[]
+   @returns  false if the work buffer ran out, so parts may be unfilled
+*/
+/**************************************************************************/
+bool GFXcanvas16::floodFill(int16_t x, int16_t y, uint16_t color,
+                            GFXfillSpan *work, uint16_t size) {
+  if (!buffer || !clipPixel(&x, &y))
+    return true;
+  GFXrect b = {clip_x0, clip_y0, (int16_t)(clip_x1 - clip_x0),
+               (int16_t)(clip_y1 - clip_y0)};
+  return spanFill(this, &GFXcanvas16::getRawPixel,
+                  &GFXcanvas16::drawFastRawHLine, x, y, color, color, b, work,
+                  size);
+}
+
 /**************************************************************************/
 /*!
     @brief  Fill the framebuffer completely with one color
@@ -2488,15 +4716,12 @@ uint16_t GFXcanvas16::getRawPixel(int16_t x, int16_t y) const {
 */
 /**************************************************************************/
 void GFXcanvas16::fillScreen(uint16_t color) {
+  if (clipped()) { // Only the clip rectangle
+    Adafruit_GFX::fillScreen(color);
+    return;
+  }
   if (buffer) {
-    uint8_t hi = color >> 8, lo = color & 0xFF;
-    if (hi == lo) {
-      memset(buffer, lo, WIDTH * HEIGHT * 2);
-    } else {
-      uint32_t i, pixels = WIDTH * HEIGHT;
-      for (i = 0; i < pixels; i++)
-        buffer[i] = color;
-    }
+    fillWords(buffer, toStorage(color), (uint32_t)WIDTH * HEIGHT);
   }
 }
 
@@ -2521,6 +4746,27 @@ void GFXcanvas16::byteSwap(void) {
   }
 }
 
+/**************************************************************************/
+/*!
+    @brief  Choose the byte order pixels are stored in. In big-endian mode
+            the buffer already holds what an SPI or 8-bit parallel display
+            expects, so it can be pushed (see Adafruit_SPITFT::drawCanvas()
+            or writePixels() with bigEndian set) without swapping every
+            pixel beforehand and back afterward. Drawing functions take,
+            and getPixel() returns, normal 5-6-5 colors either way; the
+            color is swapped once per call. Switching modes converts the
+            current contents.
+    @param  be  true to store pixels big-endian, false (default) for
+                native order
+*/
+/**************************************************************************/
+void GFXcanvas16::setBigEndian(bool be) {
+  if (be != big_endian) {
+    byteSwap();
+    big_endian = be;
+  }
+}
+
 /**************************************************************************/
 /*!
    @brief    Speed optimized vertical line drawing
@@ -2532,47 +4778,11 @@ void GFXcanvas16::byteSwap(void) {
 /**************************************************************************/
 void GFXcanvas16::drawFastVLine(int16_t x, int16_t y, int16_t h,
                                 uint16_t color) {
-  if (h < 0) { // Convert negative heights to positive equivalent
-    h *= -1;
-    y -= h - 1;
-    if (y < 0) {
-      h += y;
-      y = 0;
-    }
-  }
-
-  // Edge rejection (no-draw if totally off canvas)
-  if ((x < 0) || (x >= width()) || (y >= height()) || ((y + h - 1) < 0)) {
+  if (!clipVLine(&x, &y, &h)) // Off canvas or clip rectangle
     return;
-  }
-
-  if (y < 0) { // Clip top
-    h += y;
-    y = 0;
-  }
-  if (y + h > height()) { // Clip bottom
-    h = height() - y;
-  }
-
-  if (getRotation() == 0) {
-    drawFastRawVLine(x, y, h, color);
-  } else if (getRotation() == 1) {
-    int16_t t = x;
-    x = WIDTH - 1 - y;
-    y = t;
-    x -= h - 1;
-    drawFastRawHLine(x, y, h, color);
-  } else if (getRotation() == 2) {
-    x = WIDTH - 1 - x;
-    y = HEIGHT - 1 - y;
 
-    y -= h - 1;
-    drawFastRawVLine(x, y, h, color);
-  } else if (getRotation() == 3) {
-    int16_t t = x;
-    x = y;
-    y = HEIGHT - 1 - t;
-    drawFastRawHLine(x, y, h, color);
+  if (buffer) {
+    drawSpan(pixel_origin + x * x_step + y * y_step, y_step, h, color);
   }
 }
 
@@ -2587,47 +4797,11 @@ void GFXcanvas16::drawFastVLine(int16_t x, int16_t y, int16_t h,
 /**************************************************************************/
 void GFXcanvas16::drawFastHLine(int16_t x, int16_t y, int16_t w,
                                 uint16_t color) {
-  if (w < 0) { // Convert negative widths to positive equivalent
-    w *= -1;
-    x -= w - 1;
-    if (x < 0) {
-      w += x;
-      x = 0;
-    }
-  }
-
-  // Edge rejection (no-draw if totally off canvas)
-  if ((y < 0) || (y >= height()) || (x >= width()) || ((x + w - 1) < 0)) {
+  if (!clipHLine(&x, &y, &w)) // Off canvas or clip rectangle
     return;
-  }
-
-  if (x < 0) { // Clip left
-    w += x;
-    x = 0;
-  }
-  if (x + w >= width()) { // Clip right
-    w = width() - x;
-  }
-
-  if (getRotation() == 0) {
-    drawFastRawHLine(x, y, w, color);
-  } else if (getRotation() == 1) {
-    int16_t t = x;
-    x = WIDTH - 1 - y;
-    y = t;
-    drawFastRawVLine(x, y, w, color);
-  } else if (getRotation() == 2) {
-    x = WIDTH - 1 - x;
-    y = HEIGHT - 1 - y;
 
-    x -= w - 1;
-    drawFastRawHLine(x, y, w, color);
-  } else if (getRotation() == 3) {
-    int16_t t = x;
-    x = y;
-    y = HEIGHT - 1 - t;
-    y -= w - 1;
-    drawFastRawVLine(x, y, w, color);
+  if (buffer) {
+    drawSpan(pixel_origin + x * x_step + y * y_step, x_step, w, color);
   }
 }
 
@@ -2643,10 +4817,19 @@ void GFXcanvas16::drawFastHLine(int16_t x, int16_t y, int16_t w,
 void GFXcanvas16::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
                                    uint16_t color) {
   // x & y already in raw (rotation 0) coordinates, no need to transform.
+  color = toStorage(color);
   uint16_t *buffer_ptr = buffer + y * WIDTH + x;
-  for (int16_t i = 0; i < h; i++) {
+  const int32_t stride = WIDTH;
+  for (; h >= 4; h -= 4) { // Unrolled, stride folded into the offsets
+    buffer_ptr[0] = color;
+    buffer_ptr[stride] = color;
+    buffer_ptr[2 * stride] = color;
+    buffer_ptr[3 * stride] = color;
+    buffer_ptr += 4 * stride;
+  }
+  for (; h > 0; h--) {
     (*buffer_ptr) = color;
-    buffer_ptr += WIDTH;
+    buffer_ptr += stride;
   }
 }
 
@@ -2662,8 +4845,508 @@ void GFXcanvas16::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
 void GFXcanvas16::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
                                    uint16_t color) {
   // x & y already in raw (rotation 0) coordinates, no need to transform.
-  uint32_t buffer_index = y * WIDTH + x;
-  for (uint32_t i = buffer_index; i < buffer_index + w; i++) {
-    buffer[i] = color;
+  if (w > 0)
+    fillWords(buffer + (uint32_t)y * WIDTH + x, toStorage(color), w);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Map a rectangle from rotated to raw (unrotated) coordinates
+   @param    x   Left edge, in; raw left edge, out
+   @param    y   Top edge, in; raw top edge, out
+   @param    w   Width, in; raw width, out (height if rotated 90/270)
+   @param    h   Height, in; raw height, out
+*/
+/**************************************************************************/
+void GFXcanvas16::rawRect(int16_t *x, int16_t *y, int16_t *w,
+                          int16_t *h) const {
+  rotateRect(rotation, WIDTH, HEIGHT, x, y, w, h);
+}
+
+#define GFX_BLIT_COPY 0 ///< blitRect(): copy every pixel
+#define GFX_BLIT_KEY 1  ///< blitRect(): skip pixels matching the key color
+#define GFX_BLIT_MASK 2 ///< blitRect(): copy only where the mask bit is set
+
+/**************************************************************************/
+/*!
+   @brief    Shared worker for blit(), blitKeyed() and blitMasked(). Clips
+             the rectangle to both canvases in their rotated coordinates.
+             When both have the same rotation the copy runs on whole raw
+             rows (memmove() for plain copies); otherwise it walks each
+             canvas with its rotation strides.
+   @param    src   Source canvas, may be this canvas
+   @param    sx    Source left edge
+   @param    sy    Source top edge
+   @param    w     Width of the area to copy
+   @param    h     Height of the area to copy
+   @param    dx    Destination left edge
+   @param    dy    Destination top edge
+   @param    mode  GFX_BLIT_COPY, GFX_BLIT_KEY or GFX_BLIT_MASK
+   @param    key   Transparent 16-bit 5-6-5 color for GFX_BLIT_KEY
+   @param    mask  1-bit mask for GFX_BLIT_MASK, the size and rotation of
+                   src; nothing is drawn otherwise
+*/
+/**************************************************************************/
+void GFXcanvas16::blitRect(const GFXcanvas16 *src, int16_t sx, int16_t sy,
+                           int16_t w, int16_t h, int16_t dx, int16_t dy,
+                           uint8_t mode, uint16_t key,
+                           const GFXcanvas1 *mask) {
+  if (!buffer || !src || !src->buffer)
+    return;
+  const uint8_t *mbuf = NULL;
+  int16_t mrow = 0; // Mask bytes per raw row
+  if (mode == GFX_BLIT_MASK) {
+    // Same size and rotation, so its raw bits line up with src's raw
+    // pixels
+    if (!mask || !(mbuf = mask->getBuffer()) ||
+        (mask->getRotation() != src->rotation) ||
+        (mask->width() != src->width()) || (mask->height() != src->height()))
+      return;
+    mrow = (src->WIDTH + 7) / 8;
+  }
+  dx += origin_x; // Viewport to canvas coordinates
+  dy += origin_y;
+
+  if (sx < 0) { // Clip to source
+    w += sx;
+    dx -= sx;
+    sx = 0;
+  }
+  if (sy < 0) {
+    h += sy;
+    dy -= sy;
+    sy = 0;
+  }
+  if (dx < clip_x0) { // Clip to destination clip rectangle
+    w -= clip_x0 - dx;
+    sx += clip_x0 - dx;
+    dx = clip_x0;
+  }
+  if (dy < clip_y0) {
+    h -= clip_y0 - dy;
+    sy += clip_y0 - dy;
+    dy = clip_y0;
+  }
+  if (w > src->_width - sx)
+    w = src->_width - sx;
+  if (h > src->_height - sy)
+    h = src->_height - sy;
+  if (w > clip_x1 - dx)
+    w = clip_x1 - dx;
+  if (h > clip_y1 - dy)
+    h = clip_y1 - dy;
+  if ((w <= 0) || (h <= 0))
+    return;
+
+  bool swap = (big_endian != src->big_endian);
+  key = src->toStorage(key); // Compare against stored source pixels
+
+  if (rotation != src->rotation) {
+    // Different orientations (so different canvases): follow both strides
+    const uint16_t *srow =
+        src->buffer + src->pixel_origin + sx * src->x_step + sy * src->y_step;
+    uint16_t *drow = buffer + pixel_origin + dx * x_step + dy * y_step;
+    for (int16_t j = 0; j < h; j++) {
+      const uint16_t *s = srow;
+      uint16_t *d = drow;
+      for (int16_t i = 0; i < w; i++) {
+        uint16_t c = *s;
+        if (((mode != GFX_BLIT_KEY) || (c != key)) &&
+            ((mode != GFX_BLIT_MASK) || mask->getPixel(sx + i, sy + j)))
+          *d = swap ? __builtin_bswap16(c) : c;
+        s += src->x_step;
+        d += x_step;
+      }
+      srow += src->y_step;
+      drow += y_step;
+    }
+    return;
+  }
+
+  // Same orientation: the area is a plain rectangle in both raw buffers
+  int16_t rw = w, rh = h;
+  src->rawRect(&sx, &sy, &rw, &rh);
+  rawRect(&dx, &dy, &w, &h);
+  const uint16_t *s = src->buffer + (int32_t)sy * src->WIDTH + sx;
+  uint16_t *d = buffer + (int32_t)dy * WIDTH + dx;
+  int32_t sstride = src->WIDTH, dstride = WIDTH;
+  int16_t ystep = 1;
+  if ((src == this) && (dy > sy)) { // Overlap moving down: go bottom-up
+    s += (h - 1) * sstride;
+    d += (h - 1) * dstride;
+    sy += h - 1;
+    sstride = -sstride;
+    dstride = -dstride;
+    ystep = -1;
+  }
+  // Overlap moving right within the same rows: per-pixel modes go
+  // right-to-left (memmove() sorts this out by itself)
+  bool rtl = (src == this) && (dy == sy) && (dx > sx);
+
+  for (; h > 0; h--) {
+    if ((mode == GFX_BLIT_COPY) && !swap) {
+      memmove(d, s, w * sizeof(uint16_t));
+    } else {
+      const uint8_t *m = mbuf ? mbuf + (int32_t)sy * mrow : NULL;
+      for (int16_t n = 0; n < w; n++) {
+        int16_t i = rtl ? (w - 1 - n) : n;
+        uint16_t c = s[i];
+        if ((mode == GFX_BLIT_KEY) && (c == key))
+          continue;
+        if ((mode == GFX_BLIT_MASK) &&
+            !(m[(sx + i) >> 3] & (0x80 >> ((sx + i) & 7))))
+          continue;
+        d[i] = swap ? __builtin_bswap16(c) : c;
+      }
+    }
+    s += sstride;
+    d += dstride;
+    sy += ystep;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Copy a rectangle of pixels from another 16-bit canvas (or
+             this one), clipped to both. Copying within a canvas is safe
+             for overlapping areas, e.g. to scroll a region.
+   @param    src   Source canvas
+   @param    sx    Source left edge
+   @param    sy    Source top edge
+   @param    w     Width of the area to copy
+   @param    h     Height of the area to copy
+   @param    dx    Destination left edge
+   @param    dy    Destination top edge
+*/
+/**************************************************************************/
+void GFXcanvas16::blit(const GFXcanvas16 *src, int16_t sx, int16_t sy,
+                       int16_t w, int16_t h, int16_t dx, int16_t dy) {
+  blitRect(src, sx, sy, w, h, dx, dy, GFX_BLIT_COPY, 0, NULL);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Copy a rectangle of pixels from another 16-bit canvas, leaving
+             the destination untouched wherever the source holds the key
+             color (sprite transparency). Clipped to both canvases.
+   @param    src   Source canvas
+   @param    sx    Source left edge
+   @param    sy    Source top edge
+   @param    w     Width of the area to copy
+   @param    h     Height of the area to copy
+   @param    dx    Destination left edge
+   @param    dy    Destination top edge
+   @param    key   16-bit 5-6-5 color treated as transparent
+*/
+/**************************************************************************/
+void GFXcanvas16::blitKeyed(const GFXcanvas16 *src, int16_t sx, int16_t sy,
+                            int16_t w, int16_t h, int16_t dx, int16_t dy,
+                            uint16_t key) {
+  blitRect(src, sx, sy, w, h, dx, dy, GFX_BLIT_KEY, key, NULL);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Copy a rectangle of pixels from another 16-bit canvas, but
+             only where the matching bit of a 1-bit mask is set. Clipped to
+             both canvases.
+   @param    src   Source canvas
+   @param    sx    Source left edge
+   @param    sy    Source top edge
+   @param    w     Width of the area to copy
+   @param    h     Height of the area to copy
+   @param    dx    Destination left edge
+   @param    dy    Destination top edge
+   @param    mask  1-bit canvas with the same size and rotation as src;
+                   nothing is drawn if they differ
+*/
+/**************************************************************************/
+void GFXcanvas16::blitMasked(const GFXcanvas16 *src, int16_t sx, int16_t sy,
+                             int16_t w, int16_t h, int16_t dx, int16_t dy,
+                             const GFXcanvas1 *mask) {
+  blitRect(src, sx, sy, w, h, dx, dy, GFX_BLIT_MASK, 0, mask);
+}
+
+// Alpha blending works on 5-6-5 pixels "spread" into 32 bits as
+// 00000GGGGGG00000RRRRR000000BBBBB, leaving a gap below each field.
+// Scaling by a 0-32 weight then shifting down 5 blends all three channels
+// with one multiply: each field's fractional bits fall into its gap and
+// are masked off, and a borrow past the top lands outside the mask too.
+#define GFX_SPREAD_MASK 0x07E0F81FUL ///< Channel bits of a spread pixel
+
+/**************************************************************************/
+/*!
+   @brief    Spread a 5-6-5 color for blending
+   @param    c  16-bit 5-6-5 color
+   @returns  The color with green moved up into the top half
+*/
+/**************************************************************************/
+static inline uint32_t spread565(uint16_t c) {
+  return (c | ((uint32_t)c << 16)) & GFX_SPREAD_MASK;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Blend a spread color over a 5-6-5 pixel
+   @param    fg  Spread foreground color, see spread565()
+   @param    bg  16-bit 5-6-5 background pixel
+   @param    a   Foreground weight, 0 (bg only) to 32 (fg only)
+   @returns  The blended 16-bit 5-6-5 color
+*/
+/**************************************************************************/
+static inline uint16_t blend565(uint32_t fg, uint16_t bg, uint8_t a) {
+  uint32_t b = spread565(bg);
+  b = (((fg - b) * a >> 5) + b) & GFX_SPREAD_MASK;
+  return (uint16_t)(b | (b >> 16));
+}
+
+/**************************************************************************/
+/*!
+   @brief    Blend one color over a clipped run of pixels starting at a
+             buffer index and advancing by a fixed step. Contiguous runs
+             in native byte order blend two pixels per 64-bit multiply on
+             CPUs with 64-bit registers.
+   @param    index  Buffer index of the first pixel
+   @param    step   Buffer index increment between pixels
+   @param    n      Number of pixels, already clipped to the canvas
+   @param    color  16-bit 5-6-5 color to blend in
+   @param    a      Weight of color, 0 to 32
+*/
+/**************************************************************************/
+void GFXcanvas16::blendSpan(int32_t index, int32_t step, int16_t n,
+                            uint16_t color, uint8_t a) {
+  if ((n <= 0) || !a)
+    return;
+  if (a >= 32) { // Opaque, plain fill
+    drawSpan(index, step, n, color);
+    return;
+  }
+  uint16_t *ptr = buffer + index;
+  uint32_t fg = spread565(color);
+#if UINTPTR_MAX > 0xFFFFFFFFUL
+  if (((step == 1) || (step == -1)) && !big_endian) {
+    if (step == -1) // Same pixels, walked forward
+      ptr -= n - 1;
+    const uint64_t mask = GFX_SPREAD_MASK | ((uint64_t)GFX_SPREAD_MASK << 32);
+    uint64_t fg2 = fg | ((uint64_t)fg << 32);
+    for (; n >= 2; n -= 2, ptr += 2) {
+      uint64_t b = spread565(ptr[0]) | ((uint64_t)spread565(ptr[1]) << 32);
+      b = (((fg2 - b) * a >> 5) + b) & mask;
+      uint32_t lo = (uint32_t)b, hi = (uint32_t)(b >> 32);
+      ptr[0] = (uint16_t)(lo | (lo >> 16));
+      ptr[1] = (uint16_t)(hi | (hi >> 16));
+    }
+    if (n)
+      *ptr = blend565(fg, *ptr, a);
+    return;
+  }
+#endif
+  for (; n > 0; n--, ptr += step)
+    *ptr = toStorage(blend565(fg, toStorage(*ptr), a));
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw a translucent horizontal line
+   @param    x      Left edge
+   @param    y      Row
+   @param    w      Length in pixels
+   @param    color  16-bit 5-6-5 color
+   @param    alpha  Opacity, 0 (invisible) to 255 (opaque)
+*/
+/**************************************************************************/
+void GFXcanvas16::drawFastHLineAlpha(int16_t x, int16_t y, int16_t w,
+                                     uint16_t color, uint8_t alpha) {
+  fillRectAlpha(x, y, w, 1, color, alpha);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Blend a solid color over a rectangle, e.g. to dim part of the
+             canvas under a popup
+   @param    x      Left edge
+   @param    y      Top edge
+   @param    w      Width
+   @param    h      Height
+   @param    color  16-bit 5-6-5 color
+   @param    alpha  Opacity, 0 (invisible) to 255 (opaque)
+*/
+/**************************************************************************/
+void GFXcanvas16::fillRectAlpha(int16_t x, int16_t y, int16_t w, int16_t h,
+                                uint16_t color, uint8_t alpha) {
+  if (!buffer || (w <= 0) || (h <= 0) || !clipRect(&x, &y, &w, &h))
+    return;
+
+  uint8_t a = (alpha + 4) >> 3; // 0-255 to 0-32
+  int32_t index = pixel_origin + x * x_step + y * y_step;
+  for (; h > 0; h--, index += y_step)
+    blendSpan(index, x_step, w, color, a);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw a RGB bitmap with a per-pixel alpha channel, e.g. an
+             anti-aliased icon. Clipped to the canvas.
+   @param    x       Left edge
+   @param    y       Top edge
+   @param    bitmap  w*h 16-bit 5-6-5 pixels, row by row
+   @param    alpha   w*h opacities, 0 (transparent) to 255 (opaque)
+   @param    w       Width of the bitmap
+   @param    h       Height of the bitmap
+*/
+/**************************************************************************/
+void GFXcanvas16::drawRGBBitmapAlpha(int16_t x, int16_t y,
+                                     const uint16_t *bitmap,
+                                     const uint8_t *alpha, int16_t w,
+                                     int16_t h) {
+  blendBitmap(x, y, bitmap, alpha, 8, w, h);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw a RGB bitmap with a 4-bit alpha channel, half the size of
+             an 8-bit one. Clipped to the canvas.
+   @param    x       Left edge
+   @param    y       Top edge
+   @param    bitmap  w*h 16-bit 5-6-5 pixels, row by row
+   @param    alpha   Opacities 0 (transparent) to 15 (opaque), two per
+                     byte with the left pixel in the high nibble. Each row
+                     starts on a new byte.
+   @param    w       Width of the bitmap
+   @param    h       Height of the bitmap
+*/
+/**************************************************************************/
+void GFXcanvas16::drawRGBBitmapAlpha4(int16_t x, int16_t y,
+                                      const uint16_t *bitmap,
+                                      const uint8_t *alpha, int16_t w,
+                                      int16_t h) {
+  blendBitmap(x, y, bitmap, alpha, 4, w, h);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Shared worker for drawRGBBitmapAlpha() and
+             drawRGBBitmapAlpha4(). Fully transparent pixels are skipped
+             and fully opaque ones copied without a multiply.
+   @param    x       Left edge
+   @param    y       Top edge
+   @param    bitmap  w*h 16-bit 5-6-5 pixels
+   @param    alpha   Alpha channel, 8 or 4 bits per pixel
+   @param    bits    Bits per alpha value, 8 or 4
+   @param    w       Width of the bitmap
+   @param    h       Height of the bitmap
+*/
+/**************************************************************************/
+void GFXcanvas16::blendBitmap(int16_t x, int16_t y, const uint16_t *bitmap,
+                              const uint8_t *alpha, uint8_t bits, int16_t w,
+                              int16_t h) {
+  int16_t bx = x, by = y, saveW = w;
+  if (!buffer || (w <= 0) || (h <= 0) || !clipRect(&x, &y, &w, &h))
+    return;
+  bx = x - (bx + origin_x); // Clipped top-left within bitmap
+  by = y - (by + origin_y);
+
+  int16_t alphaRow = (bits == 8) ? saveW : (saveW + 1) / 2; // Bytes per row
+  int32_t row = pixel_origin + x * x_step + y * y_step;
+  for (int16_t j = 0; j < h; j++, row += y_step) {
+    const uint16_t *src = bitmap + (int32_t)(by + j) * saveW + bx;
+    const uint8_t *arow = alpha + (int32_t)(by + j) * alphaRow;
+    uint16_t *dst = buffer + row;
+    for (int16_t i = 0; i < w; i++, dst += x_step) {
+      uint8_t a;
+      if (bits == 8) {
+        a = (arow[bx + i] + 4) >> 3;
+      } else {
+        uint8_t nib = arow[(bx + i) >> 1];
+        nib = ((bx + i) & 1) ? (nib & 0x0F) : (nib >> 4);
+        a = (nib * 17 + 4) >> 3; // 0-15 to 0-32
+      }
+      if (!a)
+        continue;
+      *dst = (a >= 32) ? toStorage(src[i])
+                       : toStorage(blend565(spread565(src[i]),
+                                            toStorage(*dst), a));
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Check whether two rectangles overlap or share an edge, i.e.
+             whether their union covers no more than both of them do
+   @param    a  First rectangle
+   @param    b  Second rectangle
+   @returns  true if merging them wastes nothing along the shared side
+*/
+/**************************************************************************/
+static bool rectsTouch(const GFXrect &a, const GFXrect &b) {
+  return (a.x <= b.x + b.w) && (b.x <= a.x + a.w) && (a.y <= b.y + b.h) &&
+         (b.y <= a.y + a.h);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Smallest rectangle covering two others
+   @param    a  First rectangle
+   @param    b  Second rectangle
+   @returns  The bounding rectangle
+*/
+/**************************************************************************/
+static GFXrect rectUnion(const GFXrect &a, const GFXrect &b) {
+  GFXrect u;
+  int16_t x2 = a.x + a.w, y2 = a.y + a.h;
+  if (b.x + b.w > x2)
+    x2 = b.x + b.w;
+  if (b.y + b.h > y2)
+    y2 = b.y + b.h;
+  u.x = (a.x < b.x) ? a.x : b.x;
+  u.y = (a.y < b.y) ? a.y : b.y;
+  u.w = x2 - u.x;
+  u.h = y2 - u.y;
+  return u;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Add a damaged area, merging it with any it touches
+   @param    x  Left edge
+   @param    y  Top edge
+   @param    w  Width, nothing is added if <= 0
+   @param    h  Height, nothing is added if <= 0
+*/
+/**************************************************************************/
+void GFXdamage::add(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if ((w <= 0) || (h <= 0))
+    return;
+  GFXrect r = {x, y, w, h};
+  for (;;) {
+    for (uint8_t i = 0; i < count;) {
+      if (rectsTouch(rects[i], r)) {
+        // Absorb it, then start over: the bigger area may now reach others
+        r = rectUnion(rects[i], r);
+        rects[i] = rects[--count];
+        i = 0;
+      } else {
+        i++;
+      }
+    }
+    if (count < GFX_DAMAGE_RECTS) {
+      rects[count++] = r;
+      return;
+    }
+    // Full: fold into the entry that grows the least, and take that one
+    // out too, so the grown area is merged with any others it now reaches
+    uint8_t best = 0;
+    int32_t bestGrowth = INT32_MAX;
+    for (uint8_t i = 0; i < count; i++) {
+      GFXrect u = rectUnion(rects[i], r);
+      int32_t growth = (int32_t)u.w * u.h - (int32_t)rects[i].w * rects[i].h;
+      if (growth < bestGrowth) {
+        bestGrowth = growth;
+        best = i;
+      }
+    }
+    r = rectUnion(rects[best], r);
+    rects[best] = rects[--count];
   }
 }
@@ -12,6 +12,64 @@
 #include "libs/Adafruit_BusIO_SR/Adafruit_I2CDevice_SR.h"
 #include "libs/Adafruit_BusIO_SR/Adafruit_SPIDevice_SR.h"
 
+#ifndef GFX_CLIP_DEPTH
+#define GFX_CLIP_DEPTH 4 ///< Clip rectangles that can be pushed at once
+#endif
+
+#ifndef GFX_POLY_EDGES
+#define GFX_POLY_EDGES 32 ///< Edge table size (on the stack) for fillPolygon
+#endif
+
+#ifndef GFX_CURVE_DEPTH
+#define GFX_CURVE_DEPTH 6 ///< Halvings of a curve at most, 2^n segments
+#endif
+
+#ifndef GFX_CURVE_FLATNESS
+#define GFX_CURVE_FLATNESS 8 ///< Default curve tolerance, 1/16 pixels
+#endif
+
+#ifndef GFX_FILL_SPANS
+#define GFX_FILL_SPANS 32 ///< floodFill() work buffer on the stack, if none
+#endif
+
+/// Axis-aligned rectangle, for clipping and damage tracking
+typedef struct {
+  int16_t x; ///< Left edge
+  int16_t y; ///< Top edge
+  int16_t w; ///< Width, <= 0 if empty
+  int16_t h; ///< Height, <= 0 if empty
+} GFXrect;
+
+/// A vertex, for polygons
+typedef struct {
+  int16_t x; ///< Column
+  int16_t y; ///< Row
+} GFXpoint;
+
+/// A span waiting to be scanned by floodFill(); see its work buffer
+typedef struct {
+  int16_t x1; ///< Left end
+  int16_t x2; ///< Right end
+  int16_t y;  ///< Row the span lies on
+  int8_t dy;  ///< Row to scan next, +1 or -1 from y
+} GFXfillSpan;
+
+/// A point of a curved outline, for fillPath()
+typedef struct {
+  int16_t x;    ///< Column
+  int16_t y;    ///< Row
+  bool control; ///< Bends the outline rather than lying on it
+} GFXpathPoint;
+
+/// How fillPolygon() decides which areas of a self-intersecting or
+/// multi-loop outline are inside
+typedef enum {
+  GFX_EVEN_ODD, ///< Inside if crossed an odd number of edges from the left
+  GFX_NON_ZERO  ///< Inside if edges crossed don't cancel out by direction
+} GFXfillRule;
+
+uint32_t GFXisqrt(uint32_t v);
+
 /// A generic graphics superclass that can handle all sorts of drawing. At a
 /// minimum you can subclass and provide drawPixel(). At a maximum you can do a
 /// ton of overriding to optimize. Used for any/all Adafruit displays!
@@ -65,6 +123,9 @@ public:
                         uint16_t color);
   virtual void drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
                         uint16_t color);
+  virtual void drawPixels(const GFXpoint *points, uint16_t n, uint16_t color);
+  virtual void drawPixels(const GFXpoint *points, const uint16_t *colors,
+                          uint16_t n);
 
   // These exist only with Adafruit_GFX (no subclass overrides)
   void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
@@ -77,6 +138,25 @@ public:
                     int16_t y2, uint16_t color);
   void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2,
                     int16_t y2, uint16_t color);
+  void fillPolygon(const GFXpoint *points, uint16_t n, uint16_t color,
+                   GFXfillRule rule = GFX_EVEN_ODD);
+  void drawPolyline(const GFXpoint *points, uint16_t n, uint16_t color);
+  void drawPolygon(const GFXpoint *points, uint16_t n, uint16_t color);
+  void drawQuadBezier(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                      int16_t x2, int16_t y2, uint16_t color,
+                      uint8_t flatness = GFX_CURVE_FLATNESS);
+  void drawCubicBezier(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                       int16_t x2, int16_t y2, int16_t x3, int16_t y3,
+                       uint16_t color, uint8_t flatness = GFX_CURVE_FLATNESS);
+  void fillPath(const GFXpathPoint *points, uint16_t n, uint16_t color,
+                GFXfillRule rule = GFX_EVEN_ODD,
+                uint8_t flatness = GFX_CURVE_FLATNESS);
+  void drawThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                     int16_t width, uint16_t color);
+  void fillArc(int16_t x0, int16_t y0, int16_t r0, int16_t r1, int16_t a0,
+               int16_t a1, uint16_t color);
+  void drawRing(int16_t x0, int16_t y0, int16_t r0, int16_t r1,
+                uint16_t color);
   void drawRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
                      int16_t radius, uint16_t color);
   void fillRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
@@ -211,6 +291,47 @@ public:
   /************************************************************************/
   uint8_t getRotation(void) const { return rotation; }
 
+  // CLIPPING / VIEWPORT API
+  // Drawing coordinates are relative to the viewport's top-left corner,
+  // and everything drawn is limited to the viewport and the intersection
+  // of the pushed clip rectangles (both the whole screen by default).
+  bool pushClipRect(int16_t x, int16_t y, int16_t w, int16_t h);
+  void popClipRect(void);
+  void resetClip(void);
+  void setViewport(int16_t x, int16_t y, int16_t w, int16_t h);
+
+  /************************************************************************/
+  /*!
+    @brief  Go back to drawing on the whole screen, in screen coordinates
+  */
+  /************************************************************************/
+  void resetViewport(void) { setViewport(0, 0, _width, _height); }
+
+  /************************************************************************/
+  /*!
+    @brief      Get the area drawing is currently limited to
+    @returns    Clip rectangle in viewport coordinates, empty (w or h 0) if
+                nothing can be drawn
+  */
+  /************************************************************************/
+  GFXrect getClipRect(void) const {
+    GFXrect r = {(int16_t)(clip_x0 - origin_x), (int16_t)(clip_y0 - origin_y),
+                 (int16_t)(clip_x1 - clip_x0), (int16_t)(clip_y1 - clip_y0)};
+    return r;
+  }
+
+  /************************************************************************/
+  /*!
+    @brief      Get the viewport set by setViewport()
+    @returns    Viewport in screen coordinates, before clipping to the
+                screen edges
+  */
+  /************************************************************************/
+  GFXrect getViewport(void) const {
+    GFXrect r = {origin_x, origin_y, view_w, view_h};
+    return r;
+  }
+
   // get current cursor position (get rotation safe maximum values,
   // using: width() for x, height() for y)
   /************************************************************************/
@@ -232,6 +353,87 @@ public:
 protected:
   void charBounds(unsigned char c, int16_t *x, int16_t *y, int16_t *minx,
                   int16_t *miny, int16_t *maxx, int16_t *maxy);
+  bool clipHLine(int16_t *x, int16_t *y, int16_t *w) const;
+  bool clipVLine(int16_t *x, int16_t *y, int16_t *h) const;
+  bool clipRect(int16_t *x, int16_t *y, int16_t *w, int16_t *h) const;
+  bool triangleReject(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                      int16_t x2, int16_t y2) const;
+  void circleRun(int16_t x0, int16_t y0, int16_t xa, int16_t xb, int16_t y,
+                 uint8_t corners, uint16_t color);
+  void fillPolygonFixed(const GFXpoint *points, uint16_t n, uint8_t shift,
+                        uint16_t color, GFXfillRule rule);
+  void fillRoundRows(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                     int16_t t0, int16_t t1, int16_t dx, uint16_t color);
+  void polyLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, bool skip0,
+                bool skip1, GFXrect *run, uint16_t color);
+  void polyRun(GFXrect *run, int16_t x, int16_t y, int16_t w, int16_t h,
+               uint16_t color);
+  void drawBezier(const int32_t *c, uint8_t flatness, uint16_t color);
+
+  /************************************************************************/
+  /*!
+    @brief  Clip a single pixel, for drawPixel() implementations
+    @param  x  Pointer to x coordinate; moved to screen coordinates
+    @param  y  Pointer to y coordinate; moved to screen coordinates
+    @returns true if the pixel should be drawn
+  */
+  /************************************************************************/
+  bool clipPixel(int16_t *x, int16_t *y) const {
+    *x += origin_x;
+    *y += origin_y;
+    return ((uint16_t)(*x - clip_x0) < (uint16_t)(clip_x1 - clip_x0)) &&
+           ((uint16_t)(*y - clip_y0) < (uint16_t)(clip_y1 - clip_y0));
+  }
+
+  /************************************************************************/
+  /*!
+    @brief  Map a pixel to read back, for getPixel() implementations. Reads
+            go through the viewport like writes, but ignore clip
+            rectangles.
+    @param  x  Pointer to x coordinate; moved to screen coordinates
+    @param  y  Pointer to y coordinate; moved to screen coordinates
+    @returns true if the pixel is inside the viewport and the screen
+  */
+  /************************************************************************/
+  bool viewPixel(int16_t *x, int16_t *y) const {
+    if (((uint16_t)*x >= (uint16_t)view_w) ||
+        ((uint16_t)*y >= (uint16_t)view_h))
+      return false;
+    *x += origin_x;
+    *y += origin_y;
+    return ((uint16_t)*x < (uint16_t)_width) &&
+           ((uint16_t)*y < (uint16_t)_height);
+  }
+
+  /************************************************************************/
+  /*!
+    @brief  Test a primitive's bounding box, so it can skip all its work
+            when nothing of it would be drawn
+    @param  x  Left edge (right edge if w is negative), viewport relative
+    @param  y  Top edge (bottom edge if h is negative)
+    @param  w  Width
+    @param  h  Height
+    @returns true if the box is entirely outside the clip rectangle
+  */
+  /************************************************************************/
+  bool clipReject(int16_t x, int16_t y, int16_t w, int16_t h) const {
+    int32_t x0 = (int32_t)x + origin_x + ((w < 0) ? w + 1 : 0);
+    int32_t y0 = (int32_t)y + origin_y + ((h < 0) ? h + 1 : 0);
+    return (x0 >= clip_x1) || (y0 >= clip_y1) ||
+           (x0 + ((w < 0) ? -w : w) <= clip_x0) ||
+           (y0 + ((h < 0) ? -h : h) <= clip_y0);
+  }
+
+  /************************************************************************/
+  /*!
+    @brief  Check whether drawing is limited to less than the full screen
+    @returns true if a clip rectangle is in effect
+  */
+  /************************************************************************/
+  bool clipped(void) const {
+    return clip_x0 || clip_y0 || (clip_x1 != _width) || (clip_y1 != _height);
+  }
+
   int16_t WIDTH;        ///< This is the 'raw' display width - never changes
   int16_t HEIGHT;       ///< This is the 'raw' display height - never changes
   int16_t _width;       ///< Display width as modified by current rotation
@@ -243,9 +445,19 @@ protected:
   uint8_t textsize_x;   ///< Desired magnification in X-axis of text to print()
   uint8_t textsize_y;   ///< Desired magnification in Y-axis of text to print()
   uint8_t rotation;     ///< Display rotation (0 thru 3)
-  bool wrap;            ///< If set, 'wrap' text at right edge of display
+  bool wrap;            ///< If set, 'wrap' text at right edge of viewport
   bool _cp437;          ///< If set, use correct CP437 charset (default is off)
   GFXfont *gfxFont;     ///< Pointer to special font
+  int16_t clip_x0;      ///< Left edge of drawable area
+  int16_t clip_y0;      ///< Top edge of drawable area
+  int16_t clip_x1;      ///< Right edge of drawable area, exclusive
+  int16_t clip_y1;      ///< Bottom edge of drawable area, exclusive
+  int16_t origin_x;     ///< Viewport left edge, added to every x
+  int16_t origin_y;     ///< Viewport top edge, added to every y
+  int16_t view_w;       ///< Viewport width
+  int16_t view_h;       ///< Viewport height
+  uint8_t clip_depth;   ///< Entries used in clip_stack[]
+  GFXrect clip_stack[GFX_CLIP_DEPTH]; ///< Clip areas saved by pushClipRect()
 };
 
 /// A simple drawn button UI element
@@ -306,16 +518,71 @@ private:
   bool currstate, laststate;
 };
 
+/// Memory a canvas or driver buffer is requested in, or ended up in
+typedef enum {
+  GFX_MEM_ANY,      ///< Plain malloc(), wherever the heap puts it
+  GFX_MEM_INTERNAL, ///< Fast on-chip SRAM
+  GFX_MEM_EXTERNAL, ///< External PSRAM (ESP32 boards with SPIRAM only)
+  GFX_MEM_DMA,      ///< SRAM the DMA controller can read
+  GFX_MEM_ARENA,    ///< Carved from a caller-owned GFXarena
+  GFX_MEM_CALLER,   ///< Buffer passed in by the caller (report only)
+  GFX_MEM_NONE      ///< No buffer, allocation failed (report only)
+} GFXmemory;
+
+void *GFXalloc(uint32_t bytes, GFXmemory where);
+GFXmemory GFXmemoryOf(const void *ptr, GFXmemory where);
+
+/// A bump allocator over caller-owned memory, for placing several canvases
+/// and line buffers in one block (e.g. a static array, or a region set up
+/// at boot). Individual buffers are never freed, only the arena as a whole.
+class GFXarena {
+public:
+  /**********************************************************************/
+  /*!
+    @brief  Manage a block of memory as an arena
+    @param  mem    Start of the block
+    @param  bytes  Size of the block
+  */
+  /**********************************************************************/
+  GFXarena(void *mem, uint32_t bytes)
+      : base((uint8_t *)mem), size(bytes), used(0) {}
+  void *alloc(uint32_t bytes);
+  /**********************************************************************/
+  /*!
+    @brief  Release everything allocated so far. Canvases still using
+            the arena must not be drawn to afterward.
+  */
+  /**********************************************************************/
+  void reset(void) { used = 0; }
+  /**********************************************************************/
+  /*!
+    @brief   Get the unallocated remainder of the arena
+    @returns Free bytes, before any alignment padding
+  */
+  /**********************************************************************/
+  uint32_t available(void) const { return size - used; }
+
+private:
+  uint8_t *base;
+  uint32_t size;
+  uint32_t used;
+};
+
 /// A GFX 1-bit canvas context for graphics
 class GFXcanvas1 : public Adafruit_GFX {
 public:
   GFXcanvas1(uint16_t w, uint16_t h);
+  GFXcanvas1(uint16_t w, uint16_t h, uint8_t *buf);
+  GFXcanvas1(uint16_t w, uint16_t h, GFXmemory where);
+  GFXcanvas1(uint16_t w, uint16_t h, GFXarena &arena);
   ~GFXcanvas1(void);
   void drawPixel(int16_t x, int16_t y, uint16_t color);
   void fillScreen(uint16_t color);
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
   bool getPixel(int16_t x, int16_t y) const;
+  bool floodFill(int16_t x, int16_t y, uint16_t color,
+                 GFXfillSpan *work = NULL, uint16_t size = 0);
   /**********************************************************************/
   /*!
     @brief    Get a pointer to the internal buffer memory
@@ -323,12 +590,48 @@ public:
   */
   /**********************************************************************/
   uint8_t *getBuffer(void) const { return buffer; }
+  /**********************************************************************/
+  /*!
+    @brief    Report where the buffer was placed
+    @returns  The memory the buffer landed in, GFX_MEM_NONE if the
+              allocation failed
+  */
+  /**********************************************************************/
+  GFXmemory getBufferMemory(void) const { return buffer_mem; }
+  bool getDirtyRows(int16_t *y1, int16_t *y2) const;
+  /**********************************************************************/
+  /*!
+    @brief    Forget all changes so far, typically after the canvas was
+              pushed to the display
+  */
+  /**********************************************************************/
+  void clearDirty(void) {
+    dirty_y1 = HEIGHT;
+    dirty_y2 = -1;
+  }
+  /**********************************************************************/
+  /*!
+    @brief    Flag unrotated rows as changed, for code writing into
+              getBuffer() directly
+    @param    y1  First changed row
+    @param    y2  Last changed row
+  */
+  /**********************************************************************/
+  void markDirty(int16_t y1, int16_t y2) {
+    if (y1 < dirty_y1)
+      dirty_y1 = y1;
+    if (y2 > dirty_y2)
+      dirty_y2 = y2;
+  }
 
 protected:
   bool getRawPixel(int16_t x, int16_t y) const;
   void drawFastRawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastRawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
   uint8_t *buffer; ///< Raster data: no longer private, allow subclass access
+  GFXmemory buffer_mem; ///< Where buffer landed, see getBufferMemory()
+  int16_t dirty_y1; ///< First changed (unrotated) row since clearDirty()
+  int16_t dirty_y2; ///< Last changed (unrotated) row, < dirty_y1 if clean
 
 private:
 #ifdef __AVR__
@@ -337,16 +640,81 @@ private:
 #endif
 };
 
+/// A GFX 4-bit (16 color, palettised) canvas context for graphics
+class GFXcanvas4 : public Adafruit_GFX {
+public:
+  GFXcanvas4(uint16_t w, uint16_t h);
+  GFXcanvas4(uint16_t w, uint16_t h, uint8_t *buf);
+  GFXcanvas4(uint16_t w, uint16_t h, GFXmemory where);
+  GFXcanvas4(uint16_t w, uint16_t h, GFXarena &arena);
+  ~GFXcanvas4(void);
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void fillScreen(uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  uint8_t getPixel(int16_t x, int16_t y) const;
+  bool floodFill(int16_t x, int16_t y, uint16_t color,
+                 GFXfillSpan *work = NULL, uint16_t size = 0);
+  /**********************************************************************/
+  /*!
+   @brief    Get a pointer to the internal buffer memory. Two pixels are
+             packed per byte, leftmost pixel in the high nibble, and each
+             scanline is padded to a whole byte.
+   @returns  A pointer to the allocated buffer
+  */
+  /**********************************************************************/
+  uint8_t *getBuffer(void) const { return buffer; }
+  /**********************************************************************/
+  /*!
+   @brief    Report where the buffer was placed
+   @returns  The memory the buffer landed in, GFX_MEM_NONE if the
+             allocation failed
+  */
+  /**********************************************************************/
+  GFXmemory getBufferMemory(void) const { return buffer_mem; }
+  /**********************************************************************/
+  /*!
+   @brief    Attach a 16-entry RGB565 palette, used to expand pixel values
+             when the canvas is pushed to a color display. The table is NOT
+             copied, so it can be changed between pushes.
+   @param    pal  Pointer to 16 16-bit 5-6-5 colors, or NULL (default) for
+                  a 16-level grayscale ramp.
+  */
+  /**********************************************************************/
+  void setPalette(const uint16_t *pal) { palette = pal; }
+  /**********************************************************************/
+  /*!
+   @brief    Get the currently attached palette
+   @returns  Pointer to 16 16-bit 5-6-5 colors, or NULL if none
+  */
+  /**********************************************************************/
+  const uint16_t *getPalette(void) const { return palette; }
+
+protected:
+  uint8_t getRawPixel(int16_t x, int16_t y) const;
+  void drawFastRawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void drawFastRawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  uint8_t *buffer; ///< Raster data: no longer private, allow subclass access
+  GFXmemory buffer_mem; ///< Where buffer landed, see getBufferMemory()
+  const uint16_t *palette; ///< Optional index-to-565 lookup table
+};
+
 /// A GFX 8-bit canvas context for graphics
 class GFXcanvas8 : public Adafruit_GFX {
 public:
   GFXcanvas8(uint16_t w, uint16_t h);
+  GFXcanvas8(uint16_t w, uint16_t h, uint8_t *buf);
+  GFXcanvas8(uint16_t w, uint16_t h, GFXmemory where);
+  GFXcanvas8(uint16_t w, uint16_t h, GFXarena &arena);
   ~GFXcanvas8(void);
   void drawPixel(int16_t x, int16_t y, uint16_t color);
   void fillScreen(uint16_t color);
+  void setRotation(uint8_t r);
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
   uint8_t getPixel(int16_t x, int16_t y) const;
+  bool floodFill(int16_t x, int16_t y, uint16_t color,
+                 GFXfillSpan *work = NULL, uint16_t size = 0);
   /**********************************************************************/
   /*!
    @brief    Get a pointer to the internal buffer memory
@@ -354,25 +722,101 @@ public:
   */
   /**********************************************************************/
   uint8_t *getBuffer(void) const { return buffer; }
+  /**********************************************************************/
+  /*!
+   @brief    Report where the buffer was placed
+   @returns  The memory the buffer landed in, GFX_MEM_NONE if the
+             allocation failed
+  */
+  /**********************************************************************/
+  GFXmemory getBufferMemory(void) const { return buffer_mem; }
+  /**********************************************************************/
+  /*!
+   @brief    Attach a 256-entry RGB565 palette, used to expand pixel values
+             when the canvas is pushed to a color display. The table is NOT
+             copied: changing its entries (or attaching another table) and
+             pushing the canvas again animates the palette.
+   @param    pal  Pointer to 256 16-bit 5-6-5 colors, or NULL (default) to
+                  treat pixel values as RGB 3-3-2.
+  */
+  /**********************************************************************/
+  void setPalette(const uint16_t *pal) { palette = pal; }
+  /**********************************************************************/
+  /*!
+   @brief    Get the currently attached palette
+   @returns  Pointer to 256 16-bit 5-6-5 colors, or NULL if none
+  */
+  /**********************************************************************/
+  const uint16_t *getPalette(void) const { return palette; }
 
 protected:
   uint8_t getRawPixel(int16_t x, int16_t y) const;
   void drawFastRawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastRawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void drawSpan(int32_t index, int32_t step, int16_t n, uint16_t color);
   uint8_t *buffer; ///< Raster data: no longer private, allow subclass access
+  GFXmemory buffer_mem; ///< Where buffer landed, see getBufferMemory()
+  int32_t pixel_origin; ///< Buffer index of (0,0) at current rotation
+  int32_t x_step;       ///< Buffer index change per +1 in X at rotation
+  int32_t y_step;       ///< Buffer index change per +1 in Y at rotation
+  const uint16_t *palette; ///< Optional index-to-565 lookup table
 };
 
 ///  A GFX 16-bit canvas context for graphics
 class GFXcanvas16 : public Adafruit_GFX {
 public:
   GFXcanvas16(uint16_t w, uint16_t h);
+  GFXcanvas16(uint16_t w, uint16_t h, uint16_t *buf);
+  GFXcanvas16(uint16_t w, uint16_t h, GFXmemory where);
+  GFXcanvas16(uint16_t w, uint16_t h, GFXarena &arena);
   ~GFXcanvas16(void);
   void drawPixel(int16_t x, int16_t y, uint16_t color);
   void fillScreen(uint16_t color);
+  void setRotation(uint8_t r);
   void byteSwap(void);
+  void setBigEndian(bool be);
+  /**********************************************************************/
+  /*!
+    @brief    Check the byte order pixels are stored in
+    @returns  true if big-endian (display order), see setBigEndian()
+  */
+  /**********************************************************************/
+  bool isBigEndian(void) const { return big_endian; }
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
   uint16_t getPixel(int16_t x, int16_t y) const;
+  bool floodFill(int16_t x, int16_t y, uint16_t color,
+                 GFXfillSpan *work = NULL, uint16_t size = 0);
+  void blit(const GFXcanvas16 *src, int16_t sx, int16_t sy, int16_t w,
+            int16_t h, int16_t dx, int16_t dy);
+  void blitKeyed(const GFXcanvas16 *src, int16_t sx, int16_t sy, int16_t w,
+                 int16_t h, int16_t dx, int16_t dy, uint16_t key);
+  void blitMasked(const GFXcanvas16 *src, int16_t sx, int16_t sy, int16_t w,
+                  int16_t h, int16_t dx, int16_t dy, const GFXcanvas1 *mask);
+  /**********************************************************************/
+  /*!
+    @brief  Move a rectangle of pixels within this canvas, e.g. to scroll
+            part of it; overlapping areas are handled
+    @param  sx  Source left edge
+    @param  sy  Source top edge
+    @param  w   Width of the area to move
+    @param  h   Height of the area to move
+    @param  dx  Destination left edge
+    @param  dy  Destination top edge
+  */
+  /**********************************************************************/
+  void copyRect(int16_t sx, int16_t sy, int16_t w, int16_t h, int16_t dx,
+                int16_t dy) {
+    blit(this, sx, sy, w, h, dx, dy);
+  }
+  void drawFastHLineAlpha(int16_t x, int16_t y, int16_t w, uint16_t color,
+                          uint8_t alpha);
+  void fillRectAlpha(int16_t x, int16_t y, int16_t w, int16_t h,
+                     uint16_t color, uint8_t alpha);
+  void drawRGBBitmapAlpha(int16_t x, int16_t y, const uint16_t *bitmap,
+                          const uint8_t *alpha, int16_t w, int16_t h);
+  void drawRGBBitmapAlpha4(int16_t x, int16_t y, const uint16_t *bitmap,
+                           const uint8_t *alpha, int16_t w, int16_t h);
   /**********************************************************************/
   /*!
     @brief    Get a pointer to the internal buffer memory
@@ -380,12 +824,136 @@ public:
   */
   /**********************************************************************/
   uint16_t *getBuffer(void) const { return buffer; }
+  /**********************************************************************/
+  /*!
+    @brief    Report where the buffer was placed
+    @returns  The memory the buffer landed in, GFX_MEM_NONE if the
+              allocation failed
+  */
+  /**********************************************************************/
+  GFXmemory getBufferMemory(void) const { return buffer_mem; }
 
 protected:
   uint16_t getRawPixel(int16_t x, int16_t y) const;
   void drawFastRawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastRawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void drawSpan(int32_t index, int32_t step, int16_t n, uint16_t color);
+  void rawRect(int16_t *x, int16_t *y, int16_t *w, int16_t *h) const;
+  void blitRect(const GFXcanvas16 *src, int16_t sx, int16_t sy, int16_t w,
+                int16_t h, int16_t dx, int16_t dy, uint8_t mode,
+                uint16_t key, const GFXcanvas1 *mask);
+  void blendSpan(int32_t index, int32_t step, int16_t n, uint16_t color,
+                 uint8_t a);
+  void blendBitmap(int16_t x, int16_t y, const uint16_t *bitmap,
+                   const uint8_t *alpha, uint8_t bits, int16_t w, int16_t h);
   uint16_t *buffer; ///< Raster data: no longer private, allow subclass access
+  GFXmemory buffer_mem; ///< Where buffer landed, see getBufferMemory()
+  int32_t pixel_origin; ///< Buffer index of (0,0) at current rotation
+  int32_t x_step;       ///< Buffer index change per +1 in X at rotation
+  int32_t y_step;       ///< Buffer index change per +1 in Y at rotation
+  bool big_endian;      ///< Pixels stored byte-swapped, see setBigEndian()
+
+private:
+  /**********************************************************************/
+  /*!
+    @brief    Convert between a 5-6-5 color and its stored form
+    @param    c  Color or stored pixel
+    @returns  c, byte-swapped in big-endian mode
+  */
+  /**********************************************************************/
+  uint16_t toStorage(uint16_t c) const {
+    return big_endian ? __builtin_bswap16(c) : c;
+  }
+};
+
+
+/// Pixel storage type and canvas class behind each GFXcanvasStatic depth
+template <uint8_t BPP> struct GFXcanvasDepth;
+/// 1 bit per pixel: GFXcanvas1
+template <> struct GFXcanvasDepth<1> {
+  typedef GFXcanvas1 canvas; ///< Canvas class implementing this depth
+  typedef uint8_t pixel;     ///< Buffer element type
+};
+/// 4 bits per pixel: GFXcanvas4
+template <> struct GFXcanvasDepth<4> {
+  typedef GFXcanvas4 canvas; ///< Canvas class implementing this depth
+  typedef uint8_t pixel;     ///< Buffer element type
+};
+/// 8 bits per pixel: GFXcanvas8
+template <> struct GFXcanvasDepth<8> {
+  typedef GFXcanvas8 canvas; ///< Canvas class implementing this depth
+  typedef uint8_t pixel;     ///< Buffer element type
+};
+/// 16 bits per pixel: GFXcanvas16
+template <> struct GFXcanvasDepth<16> {
+  typedef GFXcanvas16 canvas; ///< Canvas class implementing this depth
+  typedef uint16_t pixel;     ///< Buffer element type
+};
+
+/*!
+  @brief  A canvas of fixed size whose raster lives inside the object, so
+          nothing touches the heap. Declared globally (or static) the
+          buffer lands in .bss and a too-big canvas fails at link time
+          instead of at runtime. Behaves exactly like GFXcanvas1, 4, 8 or
+          16 (selected by BPP) otherwise.
+*/
+template <uint16_t W, uint16_t H, uint8_t BPP>
+class GFXcanvasStatic : public GFXcanvasDepth<BPP>::canvas {
+public:
+  /// Pixel storage type of this depth
+  typedef typename GFXcanvasDepth<BPP>::pixel pixel_t;
+  /// Raster size in bytes, also usable to size caller-supplied buffers
+  static const uint32_t BUFFER_BYTES =
+      (BPP == 1)   ? (uint32_t)((W + 7) / 8) * H
+      : (BPP == 4) ? (uint32_t)((W + 1) / 2) * H
+                   : (uint32_t)W * H * (BPP / 8);
+  /**********************************************************************/
+  /*!
+    @brief  Instatiate the canvas on its embedded storage
+  */
+  /**********************************************************************/
+  GFXcanvasStatic(void) : GFXcanvasDepth<BPP>::canvas(W, H, storage) {}
+
+private:
+  pixel_t storage[BUFFER_BYTES / sizeof(pixel_t)];
+};
+
+#ifndef GFX_DAMAGE_RECTS
+#define GFX_DAMAGE_RECTS 8 ///< Separate damaged areas tracked per frame
+#endif
+
+/// A short list of damaged screen areas. Overlapping or touching areas are
+/// merged as they are added; once the list is full, new areas are merged
+/// into whichever existing one grows least.
+class GFXdamage {
+public:
+  GFXdamage(void) : count(0) {}
+  void add(int16_t x, int16_t y, int16_t w, int16_t h);
+  /**********************************************************************/
+  /*!
+    @brief  Forget all damage, typically once it has been repainted
+  */
+  /**********************************************************************/
+  void clear(void) { count = 0; }
+  /**********************************************************************/
+  /*!
+    @brief   Get the number of separate damaged areas
+    @returns Number of rectangles, 0 if nothing needs repainting
+  */
+  /**********************************************************************/
+  uint8_t size(void) const { return count; }
+  /**********************************************************************/
+  /*!
+    @brief   Get one damaged area
+    @param   i  Index, 0 to size() - 1
+    @returns The rectangle
+  */
+  /**********************************************************************/
+  const GFXrect &operator[](uint8_t i) const { return rects[i]; }
+
+private:
+  GFXrect rects[GFX_DAMAGE_RECTS];
+  uint8_t count;
 };
 
 #endif // _ADAFRUIT_GFX_H
@@ -282,7 +282,7 @@ bool Adafruit_GrayOLED::_init(uint8_t addr, bool reset) {
             commands as needed by one's own application.
 */
 void Adafruit_GrayOLED::drawPixel(int16_t x, int16_t y, uint16_t color) {
-  if ((x >= 0) && (x < width()) && (y >= 0) && (y < height())) {
+  if (clipPixel(&x, &y)) {
     // Pixel is in-bounds. Rotate coordinates if needed.
     switch (getRotation()) {
     case 1:
@@ -169,10 +169,11 @@ void Adafruit_SPITFT::endWrite(void)
 */
 void Adafruit_SPITFT::writePixel(int16_t x, int16_t y, uint16_t color)
 {
-    if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height))
+    if (clipPixel(&x, &y))
     {
         setAddrWindow(x, y, 1, 1);
         SPI_WRITE16(color);
+        shadowColor(color, 1);
     }
 }
 
@@ -229,7 +230,23 @@ void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block, bo
 
     // avoid paramater-not-used complaints
     (void)block;
-    (void)bigEndian;
+
+    shadowPixels(colors, len, bigEndian);
+    if (bigEndian)
+    { // Already in bus order, send memory bytes as they are
+        // One transaction per pixel, as in SPI_WRITE16(): ending it
+        // strobes the word into the panel
+        const uint8_t *bytes = (const uint8_t *)colors;
+        while (len--)
+        {
+            SPI_BEGIN_TRANSACTION();
+            hwspi._spi->transfer(bytes[0]);
+            hwspi._spi->transfer(bytes[1]);
+            SPI_END_TRANSACTION();
+            bytes += 2;
+        }
+        return;
+    }
 
     while (len--)
     {
@@ -268,6 +285,7 @@ void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t len)
     if (!len)
         return; // Avoid 0-byte transfers
 
+    shadowColor(color, len);
     while (len--)
     {
         SPI_WRITE16(color);
@@ -288,58 +306,12 @@ void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t len)
     @param  h      Rectangle height in pixels (positive = below first
                    corner, negative = above first corner).
     @param  color  16-bit fill color in '565' RGB format.
-    @note   Written in this deep-nested way because C by definition will
-            optimize for the 'if' case, not the 'else' -- avoids branches
-            and rejects clipped rectangles at the least-work possibility.
 */
 void Adafruit_SPITFT::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
 {
-    if (w && h)
-    { // Nonzero width and height?
-        if (w < 0)
-        {               // If negative width...
-            x += w + 1; //   Move X to left edge
-            w = -w;     //   Use positive width
-        }
-        if (x < _width)
-        { // Not off right
-            if (h < 0)
-            {               // If negative height...
-                y += h + 1; //   Move Y to top edge
-                h = -h;     //   Use positive height
-            }
-            if (y < _height)
-            { // Not off bottom
-                int16_t x2 = x + w - 1;
-                if (x2 >= 0)
-                { // Not off left
-                    int16_t y2 = y + h - 1;
-                    if (y2 >= 0)
-                    { // Not off top
-                        // Rectangle partly or fully overlaps screen
-                        if (x < 0)
-                        {
-                            x = 0;
-                            w = x2 + 1;
-                        } // Clip left
-                        if (y < 0)
-                        {
-                            y = 0;
-                            h = y2 + 1;
-                        } // Clip top
-                        if (x2 >= _width)
-                        {
-                            w = _width - x;
-                        } // Clip right
-                        if (y2 >= _height)
-                        {
-                            h = _height - y;
-                        } // Clip bottom
-                        writeFillRectPreclipped(x, y, w, h, color);
-                    }
-                }
-            }
-        }
+    if (clipRect(&x, &y, &w, &h))
+    { // Rectangle partly or fully inside the clip area
+        writeFillRectPreclipped(x, y, w, h, color);
     }
 }
 
@@ -357,31 +329,9 @@ void Adafruit_SPITFT::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
 */
 void inline Adafruit_SPITFT::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
 {
-    if ((y >= 0) && (y < _height) && w)
-    { // Y on screen, nonzero width
-        if (w < 0)
-        {               // If negative width...
-            x += w + 1; //   Move X to left edge
-            w = -w;     //   Use positive width
-        }
-        if (x < _width)
-        { // Not off right
-            int16_t x2 = x + w - 1;
-            if (x2 >= 0)
-            { // Not off left
-                // Line partly or fully overlaps screen
-                if (x < 0)
-                {
-                    x = 0;
-                    w = x2 + 1;
-                } // Clip left
-                if (x2 >= _width)
-                {
-                    w = _width - x;
-                } // Clip right
-                writeFillRectPreclipped(x, y, w, 1, color);
-            }
-        }
+    if (clipHLine(&x, &y, &w))
+    { // Line partly or fully inside the clip area
+        writeFillRectPreclipped(x, y, w, 1, color);
     }
 }
 
@@ -399,31 +349,9 @@ void inline Adafruit_SPITFT::writeFastHLine(int16_t x, int16_t y, int16_t w, uin
 */
 void inline Adafruit_SPITFT::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
 {
-    if ((x >= 0) && (x < _width) && h)
-    { // X on screen, nonzero height
-        if (h < 0)
-        {               // If negative height...
-            y += h + 1; //   Move Y to top edge
-            h = -h;     //   Use positive height
-        }
-        if (y < _height)
-        { // Not off bottom
-            int16_t y2 = y + h - 1;
-            if (y2 >= 0)
-            { // Not off top
-                // Line partly or fully overlaps screen
-                if (y < 0)
-                {
-                    y = 0;
-                    h = y2 + 1;
-                } // Clip top
-                if (y2 >= _height)
-                {
-                    h = _height - y;
-                } // Clip bottom
-                writeFillRectPreclipped(x, y, 1, h, color);
-            }
-        }
+    if (clipVLine(&x, &y, &h))
+    { // Line partly or fully inside the clip area
+        writeFillRectPreclipped(x, y, 1, h, color);
     }
 }
 
@@ -473,11 +401,12 @@ inline void Adafruit_SPITFT::writeFillRectPreclipped(int16_t x, int16_t y, int16
 void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color)
 {
     // Clip first...
-    if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height))
+    if (clipPixel(&x, &y))
     {
         // THEN set up transaction (if needed) and draw...
         setAddrWindow(x, y, 1, 1);
         SPI_WRITE16(color);
+        shadowColor(color, 1);
     }
 }
 
@@ -502,52 +431,9 @@ void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color)
 */
 void Adafruit_SPITFT::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
 {
-    if (w && h)
-    { // Nonzero width and height?
-        if (w < 0)
-        {               // If negative width...
-            x += w + 1; //   Move X to left edge
-            w = -w;     //   Use positive width
-        }
-        if (x < _width)
-        { // Not off right
-            if (h < 0)
-            {               // If negative height...
-                y += h + 1; //   Move Y to top edge
-                h = -h;     //   Use positive height
-            }
-            if (y < _height)
-            { // Not off bottom
-                int16_t x2 = x + w - 1;
-                if (x2 >= 0)
-                { // Not off left
-                    int16_t y2 = y + h - 1;
-                    if (y2 >= 0)
-                    { // Not off top
-                        // Rectangle partly or fully overlaps screen
-                        if (x < 0)
-                        {
-                            x = 0;
-                            w = x2 + 1;
-                        } // Clip left
-                        if (y < 0)
-                        {
-                            y = 0;
-                            h = y2 + 1;
-                        } // Clip top
-                        if (x2 >= _width)
-                        {
-                            w = _width - x;
-                        } // Clip right
-                        if (y2 >= _height)
-                        {
-                            h = _height - y;
-                        } // Clip bottom
-                        writeFillRectPreclipped(x, y, w, h, color);
-                    }
-                }
-            }
-        }
+    if (clipRect(&x, &y, &w, &h))
+    { // Rectangle partly or fully inside the clip area
+        writeFillRectPreclipped(x, y, w, h, color);
     }
 }
 
@@ -569,31 +455,9 @@ void Adafruit_SPITFT::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint1
 */
 void Adafruit_SPITFT::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
 {
-    if ((y >= 0) && (y < _height) && w)
-    { // Y on screen, nonzero width
-        if (w < 0)
-        {               // If negative width...
-            x += w + 1; //   Move X to left edge
-            w = -w;     //   Use positive width
-        }
-        if (x < _width)
-        { // Not off right
-            int16_t x2 = x + w - 1;
-            if (x2 >= 0)
-            { // Not off left
-                // Line partly or fully overlaps screen
-                if (x < 0)
-                {
-                    x = 0;
-                    w = x2 + 1;
-                } // Clip left
-                if (x2 >= _width)
-                {
-                    w = _width - x;
-                } // Clip right
-                writeFillRectPreclipped(x, y, w, 1, color);
-            }
-        }
+    if (clipHLine(&x, &y, &w))
+    { // Line partly or fully inside the clip area
+        writeFillRectPreclipped(x, y, w, 1, color);
     }
 }
 
@@ -614,30 +478,88 @@ void Adafruit_SPITFT::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t co
 */
 void Adafruit_SPITFT::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
 {
-    if ((x >= 0) && (x < _width) && h)
-    { // X on screen, nonzero height
-        if (h < 0)
-        {               // If negative height...
-            y += h + 1; //   Move Y to top edge
-            h = -h;     //   Use positive height
-        }
-        if (y < _height)
-        { // Not off bottom
-            int16_t y2 = y + h - 1;
-            if (y2 >= 0)
-            { // Not off top
-                // Line partly or fully overlaps screen
-                if (y < 0)
-                {
-                    y = 0;
-                    h = y2 + 1;
-                } // Clip top
-                if (y2 >= _height)
-                {
-                    h = _height - y;
-                } // Clip bottom
-                writeFillRectPreclipped(x, y, 1, h, color);
+    if (clipVLine(&x, &y, &h))
+    { // Line partly or fully inside the clip area
+        writeFillRectPreclipped(x, y, 1, h, color);
+    }
+}
+
+/*!
+    @brief  Draw many single pixels of one color, e.g. a scatter plot or
+            particles. Points are sorted by row in batches, and neighbors
+            in a row go out as one run, so most points cost one data word
+            plus a column change rather than a full address window each.
+    @param  points  Pixel positions, in any order.
+    @param  n       Number of points.
+    @param  color   16-bit pixel color in '565' RGB format.
+*/
+void Adafruit_SPITFT::drawPixels(const GFXpoint *points, uint16_t n, uint16_t color)
+{
+    drawPixelBatch(points, NULL, n, color);
+}
+
+/*!
+    @brief  Draw many single pixels, each its own color. Sorted and sent
+            as drawPixels(points, n, color) does; where a position
+            repeats, the later point wins.
+    @param  points  Pixel positions, in any order.
+    @param  colors  16-bit '565' RGB color of each point.
+    @param  n       Number of points.
+*/
+void Adafruit_SPITFT::drawPixels(const GFXpoint *points, const uint16_t *colors, uint16_t n)
+{
+    drawPixelBatch(points, colors, n, 0);
+}
+
+/*!
+    @brief  Sort up to SPITFT_SCATTER_POINTS clipped points at a time by
+            row, then column, dropping all but the last at any position,
+            and send each horizontal run in one address window. Rows in
+            order also let setAddrWindow() skip unchanged row addresses.
+    @param  points  Pixel positions, in any order.
+    @param  colors  Color of each point, or NULL to use color for all.
+    @param  n       Number of points.
+    @param  color   Color for every point when colors is NULL.
+*/
+void Adafruit_SPITFT::drawPixelBatch(const GFXpoint *points, const uint16_t *colors, uint16_t n, uint16_t color)
+{
+    uint32_t key[SPITFT_SCATTER_POINTS]; // Screen row << 16 | column
+    uint16_t c[SPITFT_SCATTER_POINTS];   // Color of each sorted point
+
+    for (uint16_t i = 0; i < n;)
+    {
+        uint16_t m = 0; // Points in this batch
+        for (; (i < n) && (m < SPITFT_SCATTER_POINTS); i++)
+        {
+            int16_t x = points[i].x, y = points[i].y;
+            if (!clipPixel(&x, &y))
+                continue;
+            uint32_t k = ((uint32_t)y << 16) | (uint16_t)x;
+            uint16_t j = m; // Insertion point, after any equal key
+            while (j && (key[j - 1] > k))
+                j--;
+            if (j && (key[j - 1] == k))
+            { // Same position again, later point wins
+                c[j - 1] = colors ? colors[i] : color;
+                continue;
+            }
+            for (uint16_t t = m++; t > j; t--)
+            {
+                key[t] = key[t - 1];
+                c[t] = c[t - 1];
             }
+            key[j] = k;
+            c[j] = colors ? colors[i] : color;
+        }
+        for (uint16_t a = 0, b; a < m; a = b)
+        { // Each run of neighbors in a row
+            for (b = a + 1; (b < m) && (key[b] == key[b - 1] + 1); b++)
+                ;
+            setAddrWindow(key[a] & 0xFFFF, key[a] >> 16, b - a, 1);
+            if (colors)
+                writePixels(&c[a], b - a);
+            else
+                writeColor(color, b - a);
         }
     }
 }
@@ -652,6 +574,7 @@ void Adafruit_SPITFT::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t co
 void Adafruit_SPITFT::pushColor(uint16_t color)
 {
     SPI_WRITE16(color);
+    shadowColor(color, 1);
 }
 
 /*!
@@ -672,32 +595,10 @@ void Adafruit_SPITFT::pushColor(uint16_t color)
 */
 void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int16_t w, int16_t h)
 {
-
-    int16_t x2, y2;                 // Lower-right coord
-    if ((x >= _width) ||            // Off-edge right
-        (y >= _height) ||           // " top
-        ((x2 = (x + w - 1)) < 0) || // " left
-        ((y2 = (y + h - 1)) < 0))
-        return; // " bottom
-
-    int16_t bx1 = 0, by1 = 0, // Clipped top-left within bitmap
-        saveW = w;            // Save original bitmap width value
-    if (x < 0)
-    { // Clip left
-        w += x;
-        bx1 = -x;
-        x = 0;
-    }
-    if (y < 0)
-    { // Clip top
-        h += y;
-        by1 = -y;
-        y = 0;
-    }
-    if (x2 >= _width)
-        w = _width - x; // Clip right
-    if (y2 >= _height)
-        h = _height - y; // Clip bottom
+    int16_t bx1, by1,  // Clipped top-left within bitmap
+        saveW = w;     // Save original bitmap width value
+    if (!clipImage(&x, &y, &w, &h, &bx1, &by1))
+        return;
 
     pcolors += by1 * saveW + bx1; // Offset bitmap ptr to clipped top-left
     setAddrWindow(x, y, w, h);    // Clipped area
@@ -708,6 +609,871 @@ void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int
     }
 }
 
+/*!
+    @brief  Clip an image (bitmap, canvas, etc.) against the screen edges
+            and clip rectangle, the same way drawRGBBitmap() does.
+    @param  x   Pointer to top left corner horizontal coordinate; set to
+                the clipped on-screen value.
+    @param  y   Pointer to top left corner vertical coordinate; set to the
+                clipped on-screen value.
+    @param  w   Pointer to image width in pixels; set to visible width.
+    @param  h   Pointer to image height in pixels; set to visible height.
+    @param  bx  Set to the horizontal offset of the first visible pixel
+                within the image.
+    @param  by  Set to the vertical offset of the first visible pixel
+                within the image.
+    @return true if any part of the image is visible, false if it is
+            rejected entirely (outputs are then undefined).
+*/
+bool Adafruit_SPITFT::clipImage(int16_t *x, int16_t *y, int16_t *w, int16_t *h, int16_t *bx, int16_t *by)
+{
+    if ((*w <= 0) || (*h <= 0)) // Empty image
+        return false;
+    int16_t x0 = *x, y0 = *y;
+    if (!clipRect(x, y, w, h)) // Off screen or outside the clip area
+        return false;
+    *bx = *x - (x0 + origin_x); // clipRect() moved x, y to screen coordinates
+    *by = *y - (y0 + origin_y);
+    return true;
+}
+
+/*!
+    @brief   Expand an RGB 3-3-2 byte to a 16-bit '565' RGB color. Used
+             when pushing an 8-bit canvas that has no palette attached.
+    @param   c  8-bit color, RRRGGGBB.
+    @return  'Packed' 16-bit color value (565 format).
+*/
+static inline uint16_t color332To565(uint8_t c)
+{
+    uint8_t r = c >> 5, g = (c >> 2) & 7, b = c & 3;
+    // Replicate high bits into the low ones so full-scale stays full-scale
+    return ((uint16_t)((r << 2) | (r >> 1)) << 11) | ((uint16_t)((g << 3) | g) << 5) | ((b << 3) | (b << 1) | (b >> 1));
+}
+
+/*!
+    @brief  Draw the contents of a 1-bit canvas at the specified (x,y)
+            position, using the specified foreground (for set bits) and
+            background (unset bits) colors. Unlike drawBitmap(), which
+            issues one pixel at a time, bits are expanded a byte at a time
+            into a short scratch line that is streamed inside a single
+            address window. The raw (unrotated) canvas buffer is sent;
+            handles edge clipping/rejection like drawRGBBitmap().
+    @param  x          Top left corner horizontal coordinate.
+    @param  y          Top left corner vertical coordinate.
+    @param  canvas     Pointer to the 1-bit canvas to draw.
+    @param  color      16-bit 5-6-5 color to draw set bits with.
+    @param  bg         16-bit 5-6-5 color to draw unset bits with.
+    @param  dirtyOnly  If true, only the rows changed since the last push
+                       (see GFXcanvas1::getDirtyRows()) are sent, and
+                       nothing at all if the canvas is unchanged. Either
+                       way, the canvas is marked clean afterward.
+*/
+void Adafruit_SPITFT::drawCanvas(int16_t x, int16_t y, GFXcanvas1 *canvas, uint16_t color, uint16_t bg, bool dirtyOnly)
+{
+    uint8_t *pixels = canvas->getBuffer();
+    if (!pixels)
+        return;
+    // Buffer is stored unrotated, recover its native dimensions
+    int16_t w = (canvas->getRotation() & 1) ? canvas->height() : canvas->width();
+    int16_t h = (canvas->getRotation() & 1) ? canvas->width() : canvas->height();
+    int16_t rowBytes = (w + 7) / 8; // Scanline pad = whole byte
+
+    if (dirtyOnly)
+    {
+        int16_t y1, y2;
+        if (!canvas->getDirtyRows(&y1, &y2))
+            return; // Nothing changed
+        pixels += y1 * rowBytes;
+        y += y1;
+        h = y2 - y1 + 1;
+    }
+    canvas->clearDirty();
+
+    int16_t bx1, by1; // Clipped top-left within canvas
+    if (!clipImage(&x, &y, &w, &h, &bx1, &by1))
+        return;
+
+    uint16_t stackLine[SPITFT_LINE_PIXELS];
+    uint16_t *line = lineBuf ? lineBuf : stackLine;
+    int16_t lineLen = lineBuf ? lineBufLen : SPITFT_LINE_PIXELS;
+
+    pixels += by1 * rowBytes; // Offset buffer ptr to clipped top row
+    setAddrWindow(x, y, w, h); // Clipped area
+    while (h--)
+    {                     // For each (clipped) scanline...
+        int16_t col = bx1; // Pixel (bit) index within canvas row
+        for (int16_t remaining = w; remaining > 0;)
+        {
+            int16_t n = (remaining < lineLen) ? remaining : lineLen;
+            for (int16_t i = 0; i < n;)
+            {
+                uint8_t b = pixels[col >> 3];
+                if (!(col & 7) && ((n - i) >= 8))
+                { // Whole byte, expand all 8 bits
+                    uint16_t *dst = &line[i];
+                    dst[0] = (b & 0x80) ? color : bg;
+                    dst[1] = (b & 0x40) ? color : bg;
+                    dst[2] = (b & 0x20) ? color : bg;
+                    dst[3] = (b & 0x10) ? color : bg;
+                    dst[4] = (b & 0x08) ? color : bg;
+                    dst[5] = (b & 0x04) ? color : bg;
+                    dst[6] = (b & 0x02) ? color : bg;
+                    dst[7] = (b & 0x01) ? color : bg;
+                    i += 8;
+                    col += 8;
+                }
+                else
+                { // Partial byte at either end
+                    line[i++] = (b & (0x80 >> (col & 7))) ? color : bg;
+                    col++;
+                }
+            }
+            writePixels(line, n);
+            remaining -= n;
+        }
+        pixels += rowBytes; // Advance pointer by one full (unclipped) line
+    }
+}
+
+/*!
+    @brief  Draw the contents of a 4-bit canvas at the specified (x,y)
+            position. Pixel pairs are unpacked a byte at a time through the
+            canvas palette (see GFXcanvas4::setPalette()), or a 16-level
+            grayscale ramp if none is attached, into a short scratch line
+            that is streamed inside a single address window. The raw
+            (unrotated) canvas buffer is sent; handles edge
+            clipping/rejection like drawRGBBitmap().
+    @param  x       Top left corner horizontal coordinate.
+    @param  y       Top left corner vertical coordinate.
+    @param  canvas  Pointer to the 4-bit canvas to draw.
+*/
+void Adafruit_SPITFT::drawCanvas(int16_t x, int16_t y, GFXcanvas4 *canvas)
+{
+    uint8_t *pixels = canvas->getBuffer();
+    if (!pixels)
+        return;
+    // Buffer is stored unrotated, recover its native dimensions
+    int16_t w = (canvas->getRotation() & 1) ? canvas->height() : canvas->width();
+    int16_t h = (canvas->getRotation() & 1) ? canvas->width() : canvas->height();
+    int16_t rowBytes = (w + 1) / 2; // Scanline pad = whole byte
+
+    int16_t bx1, by1; // Clipped top-left within canvas
+    if (!clipImage(&x, &y, &w, &h, &bx1, &by1))
+        return;
+
+    uint16_t gray[16];
+    const uint16_t *palette = canvas->getPalette();
+    if (!palette)
+    {
+        for (uint8_t i = 0; i < 16; i++)
+            gray[i] = color565(i * 17, i * 17, i * 17);
+        palette = gray;
+    }
+    uint16_t stackLine[SPITFT_LINE_PIXELS];
+    uint16_t *line = lineBuf ? lineBuf : stackLine;
+    int16_t lineLen = lineBuf ? lineBufLen : SPITFT_LINE_PIXELS;
+
+    pixels += by1 * rowBytes; // Offset buffer ptr to clipped top row
+    setAddrWindow(x, y, w, h); // Clipped area
+    while (h--)
+    {                     // For each (clipped) scanline...
+        int16_t col = bx1; // Pixel (nibble) index within canvas row
+        for (int16_t remaining = w; remaining > 0;)
+        {
+            int16_t n = (remaining < lineLen) ? remaining : lineLen;
+            int16_t i = 0, c = col;
+            if (c & 1) // Odd start, take low nibble of first byte alone
+                line[i++] = palette[pixels[c++ >> 1] & 0x0F];
+            const uint8_t *src = &pixels[c >> 1];
+            for (; i < n - 1; i += 2)
+            { // Two pixels per byte
+                uint8_t b = *src++;
+                line[i] = palette[b >> 4];
+                line[i + 1] = palette[b & 0x0F];
+            }
+            if (i < n) // Odd end, high nibble of last byte
+                line[i] = palette[*src >> 4];
+            writePixels(line, n);
+            col += n;
+            remaining -= n;
+        }
+        pixels += rowBytes; // Advance pointer by one full (unclipped) line
+    }
+}
+
+/*!
+    @brief  Draw the contents of an 8-bit canvas at the specified (x,y)
+            position. Each pixel value is looked up in the canvas palette
+            (see GFXcanvas8::setPalette()), or expanded as RGB 3-3-2 if
+            none is attached, into a short scratch line that is streamed
+            inside a single address window. Since the palette is read at
+            push time, changing palette entries and pushing again animates
+            colors without redrawing the canvas. The raw (unrotated) canvas
+            buffer is sent; handles edge clipping/rejection like
+            drawRGBBitmap().
+    @param  x       Top left corner horizontal coordinate.
+    @param  y       Top left corner vertical coordinate.
+    @param  canvas  Pointer to the 8-bit canvas to draw.
+*/
+void Adafruit_SPITFT::drawCanvas(int16_t x, int16_t y, GFXcanvas8 *canvas)
+{
+    uint8_t *pixels = canvas->getBuffer();
+    if (!pixels)
+        return;
+    // Buffer is stored unrotated, recover its native dimensions
+    int16_t w = (canvas->getRotation() & 1) ? canvas->height() : canvas->width();
+    int16_t h = (canvas->getRotation() & 1) ? canvas->width() : canvas->height();
+
+    int16_t bx1, by1, // Clipped top-left within canvas
+        saveW = w;    // Save original canvas width value
+    if (!clipImage(&x, &y, &w, &h, &bx1, &by1))
+        return;
+
+    const uint16_t *palette = canvas->getPalette();
+    uint16_t stackLine[SPITFT_LINE_PIXELS];
+    uint16_t *line = lineBuf ? lineBuf : stackLine;
+    int16_t lineLen = lineBuf ? lineBufLen : SPITFT_LINE_PIXELS;
+
+    pixels += by1 * saveW + bx1; // Offset buffer ptr to clipped top-left
+    setAddrWindow(x, y, w, h);   // Clipped area
+    while (h--)
+    { // For each (clipped) scanline...
+        uint8_t *src = pixels;
+        for (int16_t remaining = w; remaining > 0;)
+        {
+            int16_t n = (remaining < lineLen) ? remaining : lineLen;
+            if (palette)
+            {
+                for (int16_t i = 0; i < n; i++)
+                    line[i] = palette[src[i]];
+            }
+            else
+            {
+                for (int16_t i = 0; i < n; i++)
+                    line[i] = color332To565(src[i]);
+            }
+            writePixels(line, n);
+            src += n;
+            remaining -= n;
+        }
+        pixels += saveW; // Advance pointer by one full (unclipped) line
+    }
+}
+
+/*!
+    @brief  Draw the contents of a 16-bit canvas at the specified (x,y)
+            position. Rows are streamed straight from the canvas buffer
+            inside a single address window; a canvas in big-endian mode
+            (see GFXcanvas16::setBigEndian()) goes out with no per-pixel
+            byte swap at all. The raw (unrotated) canvas buffer is sent;
+            handles edge clipping/rejection like drawRGBBitmap().
+    @param  x       Top left corner horizontal coordinate.
+    @param  y       Top left corner vertical coordinate.
+    @param  canvas  Pointer to the 16-bit canvas to draw.
+*/
+void Adafruit_SPITFT::drawCanvas(int16_t x, int16_t y, GFXcanvas16 *canvas)
+{
+    uint16_t *pixels = canvas->getBuffer();
+    if (!pixels)
+        return;
+    // Buffer is stored unrotated, recover its native dimensions
+    int16_t w = (canvas->getRotation() & 1) ? canvas->height() : canvas->width();
+    int16_t h = (canvas->getRotation() & 1) ? canvas->width() : canvas->height();
+
+    int16_t bx1, by1, // Clipped top-left within canvas
+        saveW = w;    // Save original canvas width value
+    if (!clipImage(&x, &y, &w, &h, &bx1, &by1))
+        return;
+
+    bool bigEndian = canvas->isBigEndian();
+    pixels += by1 * saveW + bx1; // Offset buffer ptr to clipped top-left
+    setAddrWindow(x, y, w, h);   // Clipped area
+    if (w == saveW)
+    { // Full-width rows are contiguous, send in one go
+        writePixels(pixels, (uint32_t)w * h, true, bigEndian);
+        return;
+    }
+    while (h--)
+    { // For each (clipped) scanline...
+        writePixels(pixels, w, true, bigEndian);
+        pixels += saveW; // Advance pointer by one full (unclipped) line
+    }
+}
+
+/*!
+    @brief  Give drawCanvas() a heap scratch line in a chosen kind of
+            memory instead of its small stack array, e.g. DMA-capable RAM
+            so a DMA-driven writePixels() can read it directly. Any
+            previous line buffer is released first.
+    @param  pixels  Scratch line length in pixels, or 0 to go back to the
+                    stack array. Clamped to 32767.
+    @param  where   Memory to allocate in, see GFXalloc().
+    @return true on success, false if the allocation failed (drawCanvas()
+            then falls back to the stack array).
+*/
+bool Adafruit_SPITFT::setLineBuffer(uint16_t pixels, GFXmemory where)
+{
+    releaseLineBuffer();
+    if (pixels > 0x7FFF)
+        pixels = 0x7FFF;
+    if (!pixels)
+        return true;
+    if (!(lineBuf = (uint16_t *)GFXalloc(pixels * 2UL, where)))
+        return false;
+    lineBufLen = pixels;
+    lineBufMem = GFXmemoryOf(lineBuf, where);
+    return true;
+}
+
+/*!
+    @brief  Give drawCanvas() a scratch line taken from an arena. The arena
+            keeps ownership of the memory.
+    @param  pixels  Scratch line length in pixels, or 0 to go back to the
+                    stack array. Clamped to 32767.
+    @param  arena   Arena to allocate from.
+    @return true on success, false if the arena is exhausted (drawCanvas()
+            then falls back to the stack array).
+*/
+bool Adafruit_SPITFT::setLineBuffer(uint16_t pixels, GFXarena &arena)
+{
+    releaseLineBuffer();
+    if (pixels > 0x7FFF)
+        pixels = 0x7FFF;
+    if (!pixels)
+        return true;
+    if (!(lineBuf = (uint16_t *)arena.alloc(pixels * 2UL)))
+        return false;
+    lineBufLen = pixels;
+    lineBufMem = GFX_MEM_ARENA;
+    return true;
+}
+
+/*!
+    @brief  Give drawCanvas() a caller-owned scratch line. It must outlive
+            its use here; it is never freed by the driver.
+    @param  buf     Scratch line, or NULL to go back to the stack array.
+    @param  pixels  Length of buf in pixels, clamped to 32767.
+*/
+void Adafruit_SPITFT::setLineBuffer(uint16_t *buf, uint16_t pixels)
+{
+    releaseLineBuffer();
+    if (pixels > 0x7FFF)
+        pixels = 0x7FFF;
+    if (buf && pixels)
+    {
+        lineBuf = buf;
+        lineBufLen = pixels;
+        lineBufMem = GFX_MEM_CALLER;
+    }
+}
+
+/*!
+    @brief  Drop the current scratch line, freeing it if it came from the
+            heap, so drawCanvas() uses its stack array again.
+*/
+void Adafruit_SPITFT::releaseLineBuffer(void)
+{
+    if (lineBuf && (lineBufMem <= GFX_MEM_DMA))
+        free(lineBuf);
+    lineBuf = NULL;
+    lineBufLen = 0;
+    lineBufMem = GFX_MEM_NONE;
+}
+
+/*!
+    @brief  Repaint every damaged area, clipped to the screen, then forget
+            the damage. Areas wider than the band canvas are split into
+            strips; each strip goes out in one address window as a series
+            of band-sized pieces, each built by the callback just before
+            it is sent.
+    @param  damage  Areas to repaint, in screen coordinates; cleared after
+    @param  band    Canvas each piece is built in, rotation 0. Big-endian
+                    mode (see GFXcanvas16::setBigEndian()) makes pushes
+                    cheaper.
+    @param  build   Fills the top-left w x h of band for one piece
+    @param  arg     Passed to build
+*/
+void Adafruit_SPITFT::pushDamage(GFXdamage &damage, GFXcanvas16 *band,
+                                 GFXbandBuilder build, void *arg)
+{
+    uint16_t *pixels = band->getBuffer();
+    int16_t bw = band->width(), bh = band->height();
+    bool bigEndian = band->isBigEndian();
+    for (uint8_t i = 0; pixels && (i < damage.size()); i++)
+    {
+        GFXrect r = damage[i];
+        if (r.x < 0)
+        { // Clip to screen
+            r.w += r.x;
+            r.x = 0;
+        }
+        if (r.y < 0)
+        {
+            r.h += r.y;
+            r.y = 0;
+        }
+        if (r.w > _width - r.x)
+            r.w = _width - r.x;
+        if (r.h > _height - r.y)
+            r.h = _height - r.y;
+        if ((r.w <= 0) || (r.h <= 0))
+            continue;
+        for (int16_t x1 = r.x; x1 < r.x + r.w; x1 += bw)
+        { // Each strip...
+            int16_t stripW = (r.x + r.w - x1 < bw) ? r.x + r.w - x1 : bw;
+            setAddrWindow(x1, r.y, stripW, r.h);
+            for (int16_t y1 = r.y; y1 < r.y + r.h; y1 += bh)
+            { // Each band...
+                int16_t bandH = (r.y + r.h - y1 < bh) ? r.y + r.h - y1 : bh;
+                build(band, x1, y1, stripW, bandH, arg);
+                for (int16_t j = 0; j < bandH; j++)
+                    writePixels(pixels + j * bw, stripW, true, bigEndian);
+            }
+        }
+    }
+    damage.clear();
+}
+
+/*!
+    @brief  Attach a shadow canvas that mirrors every pixel the library
+            sends to the display, so areas can later be captured with
+            saveRect() (the panel itself cannot be read back over this
+            interface). Costs a row copy into the canvas per run sent.
+    @param  canvas  Canvas sized like the display at its current rotation
+                    (call again after setRotation()), or NULL to stop
+                    mirroring. It is set to rotation 0.
+*/
+void Adafruit_SPITFT::setShadow(GFXcanvas16 *canvas)
+{
+    shadow = canvas;
+    if (shadow)
+        shadow->setRotation(0);
+    shadowW = shadowH = 0; // Until the next setAddrWindow()
+}
+
+/*!
+    @brief  Copy what was last drawn in an area (see setShadow()) into a
+            buffer, e.g. before opening a popup over it.
+    @param  x    Left edge.
+    @param  y    Top edge.
+    @param  w    Width.
+    @param  h    Height.
+    @param  buf  w*h 16-bit pixels, row by row. Pixels off the display
+                 are stored as 0.
+    @return false (buf untouched) if no shadow canvas is attached.
+*/
+bool Adafruit_SPITFT::saveRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t *buf)
+{
+    if (!shadow || !shadow->getBuffer())
+        return false;
+    if ((w <= 0) || (h <= 0))
+        return true;
+    x += origin_x; // Viewport to screen coordinates, like restoreRect()
+    y += origin_y;
+    // The shadow is at rotation 0, so each row is a run of its buffer
+    const uint16_t *pixels = shadow->getBuffer();
+    int16_t sw = shadow->width(), sh = shadow->height();
+    bool swap = shadow->isBigEndian();
+    int32_t a = (x > 0) ? x : 0, b = (int32_t)x + w; // Visible columns
+    if (b > sw)
+        b = sw;
+    for (int16_t j = 0; j < h; j++, buf += w)
+    {
+        int32_t row = (int32_t)y + j;
+        if ((row < 0) || (row >= sh) || (a >= b))
+        { // Off the display
+            memset(buf, 0, w * sizeof(uint16_t));
+            continue;
+        }
+        memset(buf, 0, (a - x) * sizeof(uint16_t));
+        memset(buf + (b - x), 0, (x + w - b) * sizeof(uint16_t));
+        const uint16_t *src = pixels + row * sw + a;
+        uint16_t *dst = buf + (a - x);
+        if (swap)
+        {
+            for (int32_t i = 0; i < b - a; i++)
+                dst[i] = __builtin_bswap16(src[i]);
+        }
+        else
+        {
+            memcpy(dst, src, (b - a) * sizeof(uint16_t));
+        }
+    }
+    return true;
+}
+
+/*!
+    @brief  Put back an area saved by saveRect(), e.g. when closing a
+            popup, in one address window. Same as drawRGBBitmap(), so the
+            shadow canvas is updated too.
+    @param  x    Left edge.
+    @param  y    Top edge.
+    @param  w    Width.
+    @param  h    Height.
+    @param  buf  Pixels from saveRect().
+*/
+void Adafruit_SPITFT::restoreRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t *buf)
+{
+    drawRGBBitmap(x, y, buf, w, h);
+}
+
+/*!
+    @brief  Where a gradient fill is along its stops. Channels are kept
+            in their 5-6-5 bit depths with 11 fraction bits, so flat
+            stretches and the stop colors themselves come out exact.
+            Positions are in whatever fraction of a pixel the caller
+            steps in.
+*/
+typedef struct
+{
+    const GFXgradientStop *stops; ///< Color stops, ascending positions
+    uint8_t n;                    ///< Number of stops
+    int32_t len;                  ///< Position of stop pos 255
+    uint8_t k;                    ///< Current segment, stops k to k + 1
+    int32_t u0;                   ///< Start of the segment
+    int32_t u1;                   ///< End of the segment
+    int32_t c[3];                 ///< R, G, B at u0, << 11
+    int32_t s[3];                 ///< R, G, B change per position step, << 8
+} GFXgradientWalk;
+
+/// 4x4 ordered dither thresholds, indexed by screen row and column
+static const uint8_t bayer4[4][4] = {
+    {0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}};
+
+/*!
+    @brief  Move a gradient walk to one segment between two stops.
+    @param  g  Walk to update.
+    @param  k  Segment, 0 to n - 2 (0 if there is only one stop).
+*/
+static void gradientSegment(GFXgradientWalk *g, uint8_t k)
+{
+    uint8_t k1 = (k + 1 < g->n) ? k + 1 : k;
+    uint16_t a = g->stops[k].color, b = g->stops[k1].color;
+    int32_t ca[3] = {(int32_t)(a >> 11) << 11, (int32_t)((a >> 5) & 63) << 11, (int32_t)(a & 31) << 11};
+    int32_t cb[3] = {(int32_t)(b >> 11) << 11, (int32_t)((b >> 5) & 63) << 11, (int32_t)(b & 31) << 11};
+    g->k = k;
+    g->u0 = (int32_t)g->stops[k].pos * g->len / 255;
+    g->u1 = (int32_t)g->stops[k1].pos * g->len / 255;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        g->c[i] = ca[i];
+        g->s[i] = (g->u1 > g->u0) ? ((cb[i] - ca[i]) * 256) / (g->u1 - g->u0) : 0;
+    }
+}
+
+/*!
+    @brief  Start a gradient walk.
+    @param  g      Walk to set up.
+    @param  stops  Color stops, ascending positions.
+    @param  n      Number of stops, at least 1.
+    @param  len    Position of the last pixel, e.g. in 1/16 pixels.
+*/
+static void gradientStart(GFXgradientWalk *g, const GFXgradientStop *stops, uint8_t n, int32_t len)
+{
+    g->stops = stops;
+    g->n = n;
+    g->len = len;
+    gradientSegment(g, 0);
+}
+
+/*!
+    @brief  Color at a position along a gradient. Moving to a neighboring
+            segment is cheap, so walking the positions in order costs one
+            multiply per channel per pixel.
+    @param  g    Walk, updated to the segment containing u.
+    @param  u    Position, in the units of len; clamped to the end stops.
+    @param  thr  Rounding threshold, 0-2047: 1024 rounds to nearest, an
+                 ordered dither pattern hides 5-6-5 banding.
+    @return 16-bit 5-6-5 color.
+*/
+static uint16_t gradientColor(GFXgradientWalk *g, int32_t u, int32_t thr)
+{
+    while ((g->k + 2 < g->n) && (u >= g->u1))
+        gradientSegment(g, g->k + 1);
+    while ((g->k > 0) && (u < g->u0))
+        gradientSegment(g, g->k - 1);
+    int32_t t = u - g->u0;
+    if (t < 0)
+        t = 0;
+    else if (t > g->u1 - g->u0)
+        t = g->u1 - g->u0;
+    int32_t r = (g->c[0] + g->s[0] * t / 256 + thr) >> 11;
+    int32_t gr = (g->c[1] + g->s[1] * t / 256 + thr) >> 11;
+    int32_t b = (g->c[2] + g->s[2] * t / 256 + thr) >> 11;
+    if (r > 31)
+        r = 31;
+    if (gr > 63)
+        gr = 63;
+    if (b > 31)
+        b = 31;
+    return (r << 11) | (gr << 5) | b;
+}
+
+/*!
+    @brief  Fill a rectangle with a two-color linear gradient. See the
+            multi-stop version for details.
+    @param  x         Top left corner horizontal coordinate.
+    @param  y         Top left corner vertical coordinate.
+    @param  w         Width in pixels.
+    @param  h         Height in pixels.
+    @param  c0        16-bit 5-6-5 color at the top (or left) edge.
+    @param  c1        16-bit 5-6-5 color at the bottom (or right) edge.
+    @param  vertical  true to change color from top to bottom, false for
+                      left to right.
+    @param  dither    true to blend the 5-6-5 steps with an ordered
+                      dither pattern instead of showing bands.
+*/
+void Adafruit_SPITFT::fillRectGradient(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t c0, uint16_t c1, bool vertical, bool dither)
+{
+    GFXgradientStop stops[2] = {{0, c0}, {255, c1}};
+    GFXgradient gradient = {stops, 2};
+    fillRectGradient(x, y, w, h, gradient, vertical, dither);
+}
+
+/*!
+    @brief  Fill a rectangle with a linear gradient through any number of
+            color stops. Colors are stepped in fixed point into the
+            scratch line (see setLineBuffer()) and the whole clipped
+            rectangle is streamed in a single address window; a vertical
+            gradient without dithering needs no scratch line at all.
+    @param  x         Top left corner horizontal coordinate.
+    @param  y         Top left corner vertical coordinate.
+    @param  w         Width in pixels.
+    @param  h         Height in pixels.
+    @param  gradient  Color stops, in ascending order of position. Before
+                      the first and after the last, the color is flat.
+    @param  vertical  true to change color from top to bottom, false for
+                      left to right.
+    @param  dither    true to blend the 5-6-5 steps with an ordered
+                      dither pattern, fixed to the screen so neighboring
+                      fills line up.
+*/
+void Adafruit_SPITFT::fillRectGradient(int16_t x, int16_t y, int16_t w, int16_t h, const GFXgradient &gradient, bool vertical, bool dither)
+{
+    int16_t bx, by; // Clipped top-left within the gradient
+    int16_t len = vertical ? h : w;
+    if (!gradient.n || !clipImage(&x, &y, &w, &h, &bx, &by))
+        return;
+    GFXgradientWalk g;
+    gradientStart(&g, gradient.stops, gradient.n, (int32_t)(len - 1) * 16);
+
+    uint16_t stackLine[SPITFT_LINE_PIXELS];
+    uint16_t *line = lineBuf ? lineBuf : stackLine;
+    int16_t lineLen = lineBuf ? lineBufLen : SPITFT_LINE_PIXELS;
+
+    setAddrWindow(x, y, w, h);
+    for (int16_t row = 0; row < h; row++)
+    {
+        int16_t sy = y + row; // Screen row, for the dither pattern
+        if (vertical)
+        {
+            int32_t u = (int32_t)(by + row) * 16;
+            if (!dither)
+            { // One color per row
+                writeColor(gradientColor(&g, u, 1024), w);
+                continue;
+            }
+            uint16_t pattern[4];
+            for (uint8_t i = 0; i < 4; i++)
+                pattern[(x + i) & 3] = gradientColor(&g, u, bayer4[sy & 3][(x + i) & 3] * 128 + 64);
+            for (int16_t remaining = w, n1; remaining > 0; remaining -= n1)
+            {
+                n1 = (remaining < lineLen) ? remaining : lineLen;
+                for (int16_t i = 0; i < n1; i++)
+                    line[i] = pattern[(x + w - remaining + i) & 3];
+                writePixels(line, n1);
+            }
+            continue;
+        }
+        if (!dither && row && (w <= lineLen))
+        { // Every row the same, still in the line
+            writePixels(line, w);
+            continue;
+        }
+        for (int16_t col = 0; col < w;)
+        {
+            int16_t n1 = (w - col < lineLen) ? w - col : lineLen;
+            for (int16_t i = 0; i < n1; i++, col++)
+            {
+                int32_t thr = dither ? bayer4[sy & 3][(x + col) & 3] * 128 + 64 : 1024;
+                line[i] = gradientColor(&g, (int32_t)(bx + col) * 16, thr);
+            }
+            writePixels(line, n1);
+        }
+    }
+}
+
+/*!
+    @brief  Fill a circle with a two-color radial gradient. See the
+            multi-stop version for details.
+    @param  x0      Center-point x coordinate.
+    @param  y0      Center-point y coordinate.
+    @param  r       Radius.
+    @param  inner   16-bit 5-6-5 color at the center.
+    @param  outer   16-bit 5-6-5 color at the edge.
+    @param  dither  true to blend the 5-6-5 steps with an ordered dither
+                    pattern instead of showing rings.
+*/
+void Adafruit_SPITFT::fillCircleGradient(int16_t x0, int16_t y0, int16_t r, uint16_t inner, uint16_t outer, bool dither)
+{
+    GFXgradientStop stops[2] = {{0, inner}, {255, outer}};
+    GFXgradient gradient = {stops, 2};
+    fillCircleGradient(x0, y0, r, gradient, dither);
+}
+
+/*!
+    @brief  Fill a circle with a radial gradient through any number of
+            color stops, position 0 at the center and 255 at the edge.
+            Each row is one address window; the distance of its first
+            pixel is one GFXisqrt(), then tracked in 1/16 pixel steps
+            (1/4 past radius 2047) with running sums along the row. The
+            disc is the same as drawRing(x0, y0, 0, r).
+    @param  x0        Center-point x coordinate.
+    @param  y0        Center-point y coordinate.
+    @param  r         Radius, up to 11585.
+    @param  gradient  Color stops, in ascending order of position.
+    @param  dither    true to blend the 5-6-5 steps with an ordered dither
+                      pattern, fixed to the screen.
+*/
+void Adafruit_SPITFT::fillCircleGradient(int16_t x0, int16_t y0, int16_t r, const GFXgradient &gradient, bool dither)
+{
+    if (!gradient.n || (r < 0) || (r > 11585) || clipReject(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1))
+        return;
+    GFXgradientWalk g;
+    gradientStart(&g, gradient.stops, gradient.n, (int32_t)r * 32); // 1/32 px
+
+    uint16_t stackLine[SPITFT_LINE_PIXELS];
+    uint16_t *line = lineBuf ? lineBuf : stackLine;
+    int16_t lineLen = lineBuf ? lineBufLen : SPITFT_LINE_PIXELS;
+
+    int32_t lim = (int32_t)r * r + r; // Disc edge, as in fillArc()
+    int32_t xo = 0;                   // Half width of the current row
+    uint8_t shift = (r < 2048) ? 4 : 2; // Distance in 1/16 or 1/4 pixels
+    int32_t unit = 1L << (2 * shift);   // One pixel squared, in those steps
+    for (int32_t dy = -r; dy <= r; dy++)
+    {
+        while ((xo + 1) * (xo + 1) + dy * dy <= lim)
+            xo++;
+        while (xo * xo + dy * dy > lim)
+            xo--;
+        int16_t sx = x0 - xo, sy = y0 + dy, sw = 2 * xo + 1;
+        if (!clipHLine(&sx, &sy, &sw))
+            continue;
+        int32_t dx = sx - (x0 + origin_x); // First visible column, from center
+        uint32_t d2 = (uint32_t)(dx * dx + dy * dy) << (2 * shift);
+        uint32_t d = GFXisqrt(d2); // Distance, rounded down
+        uint32_t dd = d * d;
+        setAddrWindow(sx, sy, sw, 1);
+        for (int16_t col = 0; col < sw;)
+        {
+            int16_t n1 = (sw - col < lineLen) ? sw - col : lineLen;
+            for (int16_t i = 0; i < n1; i++, col++, dx++)
+            {
+                while (dd > d2)
+                    dd -= 2 * d-- - 1;
+                while (dd + 2 * d + 1 <= d2)
+                    dd += 2 * d++ + 1;
+                int32_t thr = dither ? bayer4[sy & 3][(sx + col) & 3] * 128 + 64 : 1024;
+                // Each step is read at its middle, except the center
+                line[i] = gradientColor(&g, d ? ((2 * d + 1) << (4 - shift)) : 0, thr);
+                d2 += (2 * dx + 1) * unit; // On to the next column
+            }
+            writePixels(line, n1);
+        }
+    }
+}
+
+/*!
+    @brief  Note the address window just set, for the shadow canvas.
+            setAddrWindow() implementations call this once the window is
+            set up; it does nothing without a shadow canvas.
+    @param  x  Left edge.
+    @param  y  Top edge.
+    @param  w  Width.
+    @param  h  Height.
+*/
+void Adafruit_SPITFT::trackWindow(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    shadowX = shadowCurX = x;
+    shadowY = shadowCurY = y;
+    shadowW = w;
+    shadowH = h;
+}
+
+/*!
+    @brief  Mirror a run of one color into the shadow canvas at the
+            current position in the address window.
+    @param  color  16-bit 5-6-5 color.
+    @param  len    Number of pixels.
+*/
+void Adafruit_SPITFT::shadowColor(uint16_t color, uint32_t len)
+{
+    if (!shadow)
+        return;
+    while (len && (shadowCurY < shadowY + shadowH))
+    {
+        int16_t n = shadowX + shadowW - shadowCurX; // Left in this row
+        if ((uint32_t)n > len)
+            n = len;
+        shadow->drawFastHLine(shadowCurX, shadowCurY, n, color);
+        len -= n;
+        if ((shadowCurX += n) >= shadowX + shadowW)
+        { // Wrap to next row, as the display does
+            shadowCurX = shadowX;
+            shadowCurY++;
+        }
+    }
+}
+
+/*!
+    @brief  Mirror a series of pixels into the shadow canvas at the current
+            position in the address window.
+    @param  colors     Pixels, as passed to writePixels().
+    @param  len        Number of pixels.
+    @param  bigEndian  true if colors are byte-swapped.
+*/
+void Adafruit_SPITFT::shadowPixels(const uint16_t *colors, uint32_t len, bool bigEndian)
+{
+    uint16_t *pixels;
+    if (!shadow || !(pixels = shadow->getBuffer()))
+        return;
+    // Copied a row at a time straight into the (rotation 0) buffer,
+    // swapped only if the byte orders differ
+    int16_t sw = shadow->width(), sh = shadow->height();
+    bool swap = (bigEndian != shadow->isBigEndian());
+    while (len && (shadowCurY < shadowY + shadowH))
+    {
+        int16_t n = shadowX + shadowW - shadowCurX; // Left in this row
+        if ((uint32_t)n > len)
+            n = len;
+        int32_t a = (shadowCurX > 0) ? shadowCurX : 0;
+        int32_t b = (int32_t)shadowCurX + n;
+        if (b > sw)
+            b = sw;
+        if ((shadowCurY >= 0) && (shadowCurY < sh) && (a < b))
+        {
+            const uint16_t *src = colors + (a - shadowCurX);
+            uint16_t *dst = pixels + (int32_t)shadowCurY * sw + a;
+            if (swap)
+            {
+                for (int32_t i = 0; i < b - a; i++)
+                    dst[i] = __builtin_bswap16(src[i]);
+            }
+            else
+            {
+                memcpy(dst, src, (b - a) * sizeof(uint16_t));
+            }
+        }
+        colors += n;
+        len -= n;
+        if ((shadowCurX += n) >= shadowX + shadowW)
+        { // Wrap to next row, as the display does
+            shadowCurX = shadowX;
+            shadowCurY++;
+        }
+    }
+}
+
 // -------------------------------------------------------------------------
 // Miscellaneous class member functions that don't draw anything.
 
@@ -70,6 +70,23 @@ typedef volatile ADAGFX_PORT_t *PORTreg_t; ///< PORT register type
 #define DEFAULT_SPI_FREQ 80000000UL ///< Hardware SPI default speed for ESP32
 #endif
 
+// Canvas pushes that need per-pixel conversion (palette lookup, bit
+// expansion) convert into a small scratch line of this many pixels on
+// the stack, then stream it, rather than needing a full-size 16-bit copy.
+#if defined(__AVR__)
+#define SPITFT_LINE_PIXELS 16 ///< Pixels converted per chunk
+#else
+#define SPITFT_LINE_PIXELS 64 ///< Pixels converted per chunk
+#endif
+
+// drawPixels() sorts this many points at a time on the stack (6 bytes
+// each); more per batch finds more neighbors to send together.
+#if defined(__AVR__)
+#define SPITFT_SCATTER_POINTS 16 ///< Points sorted per batch
+#else
+#define SPITFT_SCATTER_POINTS 128 ///< Points sorted per batch
+#endif
+
 #if defined(ADAFRUIT_PYPORTAL) || defined(ADAFRUIT_PYPORTAL_M4_TITANO) ||      \
     defined(ADAFRUIT_PYBADGE_M4_EXPRESS) ||                                    \
     defined(ADAFRUIT_PYGAMER_M4_EXPRESS) ||                                    \
@@ -101,6 +118,30 @@ typedef volatile ADAGFX_PORT_t *PORTreg_t; ///< PORT register type
 /*! For first arg to parallel constructor */
 enum tftBusWidth { tft8bitbus, tft16bitbus };
 
+/// One color stop of a gradient fill
+typedef struct {
+  uint8_t pos;    ///< Position along the gradient, 0 (start) to 255 (end)
+  uint16_t color; ///< 16-bit 5-6-5 color at that position
+} GFXgradientStop;
+
+/// Gradient through any number of color stops, in ascending position
+typedef struct {
+  const GFXgradientStop *stops; ///< Color stops; flat before first, after last
+  uint8_t n;                    ///< Number of stops
+} GFXgradient;
+
+/*!
+  @brief  Builds one band of a damaged area for Adafruit_SPITFT::pushDamage()
+  @param  band  Canvas to draw into; its (0,0) is screen (x,y)
+  @param  x     Screen column of the band's left edge
+  @param  y     Screen row of the band's top edge
+  @param  w     Columns to fill, from the band's left edge
+  @param  h     Rows to fill, from the band's top edge
+  @param  arg   The arg pointer passed to pushDamage()
+*/
+typedef void (*GFXbandBuilder)(GFXcanvas16 *band, int16_t x, int16_t y,
+                               int16_t w, int16_t h, void *arg);
+
 // CLASS DEFINITION --------------------------------------------------------
 
 /*!
@@ -146,7 +187,7 @@ public:
 
   // DESTRUCTOR ----------------------------------------------------------
 
-  ~Adafruit_SPITFT(){};
+  ~Adafruit_SPITFT() { releaseLineBuffer(); };
 
   // CLASS MEMBER FUNCTIONS ----------------------------------------------
 
@@ -234,6 +275,8 @@ public:
   void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void drawPixels(const GFXpoint *points, uint16_t n, uint16_t color);
+  void drawPixels(const GFXpoint *points, const uint16_t *colors, uint16_t n);
   // A single-pixel push encapsulated in a transaction. I don't think
   // this is used anymore (BMP demos might've used it?) but is provided
   // for backward compatibility, consider it deprecated:
@@ -242,6 +285,37 @@ public:
   using Adafruit_GFX::drawRGBBitmap; // Check base class first
   void drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int16_t w,
                      int16_t h);
+  void drawCanvas(int16_t x, int16_t y, GFXcanvas1 *canvas, uint16_t color,
+                  uint16_t bg, bool dirtyOnly = false);
+  void drawCanvas(int16_t x, int16_t y, GFXcanvas4 *canvas);
+  void drawCanvas(int16_t x, int16_t y, GFXcanvas8 *canvas);
+  void drawCanvas(int16_t x, int16_t y, GFXcanvas16 *canvas);
+  // Rebuild damaged areas a band at a time and stream them out, for
+  // compositing layers (Adafruit_SpriteLayer, Adafruit_Compositor)
+  void pushDamage(GFXdamage &damage, GFXcanvas16 *band, GFXbandBuilder build,
+                  void *arg);
+  // Scratch line used by drawCanvas(); by default a small stack array.
+  // A larger one, placed in DMA-capable or other memory, cuts per-chunk
+  // overhead. getLineBufferMemory() is GFX_MEM_NONE while on the stack.
+  bool setLineBuffer(uint16_t pixels, GFXmemory where = GFX_MEM_DMA);
+  bool setLineBuffer(uint16_t pixels, GFXarena &arena);
+  void setLineBuffer(uint16_t *buf, uint16_t pixels);
+  GFXmemory getLineBufferMemory(void) const { return lineBufMem; }
+  // Backing store for popups: a shadow canvas mirrors what was drawn
+  void setShadow(GFXcanvas16 *canvas);
+  bool saveRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t *buf);
+  void restoreRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t *buf);
+  // Gradients, computed into the scratch line above and streamed
+  void fillRectGradient(int16_t x, int16_t y, int16_t w, int16_t h,
+                        uint16_t c0, uint16_t c1, bool vertical = true,
+                        bool dither = false);
+  void fillRectGradient(int16_t x, int16_t y, int16_t w, int16_t h,
+                        const GFXgradient &gradient, bool vertical = true,
+                        bool dither = false);
+  void fillCircleGradient(int16_t x0, int16_t y0, int16_t r, uint16_t inner,
+                          uint16_t outer, bool dither = false);
+  void fillCircleGradient(int16_t x0, int16_t y0, int16_t r,
+                          const GFXgradient &gradient, bool dither = false);
 
   void invertDisplay(bool i);
   uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
@@ -323,6 +397,18 @@ protected:
   inline void TFT_CS_STROBE(void); // Parallel interface cs strobe, by Soldered
   inline void TFT_RD_HIGH(void);   // Parallel interface read high
   inline void TFT_RD_LOW(void);    // Parallel interface read low
+  // Clip an image's on-screen rectangle, returning false if fully off
+  // screen, else the visible area plus its top-left offset in the image:
+  bool clipImage(int16_t *x, int16_t *y, int16_t *w, int16_t *h, int16_t *bx,
+                 int16_t *by);
+  void releaseLineBuffer(void);
+  // drawPixels() core; colors may be NULL to use color for every point
+  void drawPixelBatch(const GFXpoint *points, const uint16_t *colors,
+                      uint16_t n, uint16_t color);
+  // setAddrWindow() implementations report the window for the shadow:
+  void trackWindow(int16_t x, int16_t y, int16_t w, int16_t h);
+  void shadowColor(uint16_t color, uint32_t len);
+  void shadowPixels(const uint16_t *colors, uint32_t len, bool bigEndian);
 
   // CLASS INSTANCE VARIABLES --------------------------------------------
 
@@ -384,6 +470,17 @@ protected:
   uint8_t invertOffCommand = 0; ///< Command to disable invert mode
 
   uint32_t _freq = 0; ///< Dummy var to keep subclasses happy
+
+  uint16_t *lineBuf = NULL;            ///< drawCanvas() scratch, NULL = stack
+  uint16_t lineBufLen = 0;             ///< Pixels in lineBuf
+  GFXmemory lineBufMem = GFX_MEM_NONE; ///< Where lineBuf was placed
+  GFXcanvas16 *shadow = NULL;          ///< Mirror of the screen, or NULL
+  int16_t shadowX = 0;                 ///< Address window left, for shadow
+  int16_t shadowY = 0;                 ///< Address window top
+  int16_t shadowW = 0;                 ///< Address window width
+  int16_t shadowH = 0;                 ///< Address window height
+  int16_t shadowCurX = 0;              ///< Next pixel in window, column
+  int16_t shadowCurY = 0;              ///< Next pixel in window, row
 };
 
 #endif // end __AVR_ATtiny85__
@@ -0,0 +1,256 @@
+/*!
+ * @file Adafruit_SpriteLayer_SR.cpp
+ *
+ * Sprite composition for Adafruit_SPITFT displays: tracks which screen
+ * areas changed between frames, rebuilds each one (background, then
+ * sprites by z order) in a small scratch canvas and streams it out in a
+ * single address window.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_SpriteLayer_SR.h"
+
+/**************************************************************************/
+/*!
+   @brief    Create a sprite layer
+   @param    display  Display to push frames to
+   @param    scratch  Canvas used to composite each damaged area. Any size
+                      works; larger means fewer, bigger pushes. It is set
+                      to rotation 0, and big-endian mode (see
+                      GFXcanvas16::setBigEndian()) makes pushes cheaper.
+*/
+/**************************************************************************/
+Adafruit_SpriteLayer::Adafruit_SpriteLayer(Adafruit_SPITFT *display,
+                                           GFXcanvas16 *scratch)
+    : display(display), scratch(scratch), background(NULL),
+      backgroundColor(0), numSprites(0) {
+  scratch->setRotation(0);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Set what appears behind the sprites. The whole screen is
+             repainted on the next update().
+   @param    canvas  Background image, drawn with its (0,0) at the screen's
+                     (0,0), or NULL for a plain color
+   @param    color   16-bit 5-6-5 color wherever canvas does not reach
+*/
+/**************************************************************************/
+void Adafruit_SpriteLayer::setBackground(GFXcanvas16 *canvas,
+                                         uint16_t color) {
+  background = canvas;
+  backgroundColor = color;
+  invalidateAll();
+}
+
+/**************************************************************************/
+/*!
+   @brief    Put a sprite on the layer; it appears on the next update()
+   @param    sprite  Sprite to add, with image, position, z etc. filled in
+   @returns  false if the layer is full or the sprite has no image
+*/
+/**************************************************************************/
+bool Adafruit_SpriteLayer::addSprite(GFXsprite *sprite) {
+  if (!sprite->image || (numSprites >= SPRITELAYER_MAX_SPRITES))
+    return false;
+  sprite->shown.w = sprite->shown.h = 0; // Not on screen yet
+  sprites[numSprites++] = sprite;
+  sortSprites();
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Take a sprite off the layer; its area is repainted on the
+             next update()
+   @param    sprite  Sprite to remove
+*/
+/**************************************************************************/
+void Adafruit_SpriteLayer::removeSprite(GFXsprite *sprite) {
+  for (uint8_t i = 0; i < numSprites; i++) {
+    if (sprites[i] == sprite) {
+      damage.add(sprite->shown.x, sprite->shown.y, sprite->shown.w,
+                 sprite->shown.h);
+      for (numSprites--; i < numSprites; i++) // Keep z order
+        sprites[i] = sprites[i + 1];
+      return;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Move a sprite. Any number of moves may happen between frames;
+             update() repaints the old and new positions once.
+   @param    sprite  Sprite to move
+   @param    x       New left edge on screen
+   @param    y       New top edge on screen
+*/
+/**************************************************************************/
+void Adafruit_SpriteLayer::moveSprite(GFXsprite *sprite, int16_t x,
+                                      int16_t y) {
+  sprite->x = x;
+  sprite->y = y;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Change a sprite's stacking order
+   @param    sprite  Sprite to restack
+   @param    z       New z, higher is drawn on top
+*/
+/**************************************************************************/
+void Adafruit_SpriteLayer::setSpriteZ(GFXsprite *sprite, int8_t z) {
+  if (sprite->z != z) {
+    sprite->z = z;
+    damageSprite(sprite);
+    sortSprites();
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Hide or show a sprite without removing it
+   @param    sprite   Sprite to change
+   @param    visible  true to show, false to hide
+*/
+/**************************************************************************/
+void Adafruit_SpriteLayer::showSprite(GFXsprite *sprite, bool visible) {
+  sprite->visible = visible;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Report that a sprite's image, mask or key changed, so its
+             area is repainted on the next update()
+   @param    sprite  Sprite that changed
+*/
+/**************************************************************************/
+void Adafruit_SpriteLayer::spriteChanged(GFXsprite *sprite) {
+  damageSprite(sprite);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Report that part of the background changed
+   @param    x  Left edge of the changed area
+   @param    y  Top edge
+   @param    w  Width
+   @param    h  Height
+*/
+/**************************************************************************/
+void Adafruit_SpriteLayer::invalidate(int16_t x, int16_t y, int16_t w,
+                                      int16_t h) {
+  damage.add(x, y, w, h);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Repaint the whole screen on the next update(), e.g. for the
+             first frame
+*/
+/**************************************************************************/
+void Adafruit_SpriteLayer::invalidateAll(void) {
+  damage.add(0, 0, display->width(), display->height());
+}
+
+/**************************************************************************/
+/*!
+   @brief    Push the next frame: every area covered by a sprite that
+             moved, appeared, disappeared or changed, or invalidated
+             since the last update(), is recomposited and sent
+*/
+/**************************************************************************/
+void Adafruit_SpriteLayer::update(void) {
+  for (uint8_t i = 0; i < numSprites; i++) {
+    GFXsprite *s = sprites[i];
+    GFXrect now = {s->x, s->y, 0, 0};
+    if (s->visible) {
+      now.w = s->image->width();
+      now.h = s->image->height();
+    }
+    if ((now.x != s->shown.x) || (now.y != s->shown.y) ||
+        (now.w != s->shown.w) || (now.h != s->shown.h)) {
+      damage.add(s->shown.x, s->shown.y, s->shown.w, s->shown.h);
+      damage.add(now.x, now.y, now.w, now.h);
+      s->shown = now;
+    }
+  }
+
+  display->pushDamage(damage, scratch, composeBand, this);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Mark a sprite's current on-screen area as needing a repaint
+   @param    sprite  Sprite whose area to repaint
+*/
+/**************************************************************************/
+void Adafruit_SpriteLayer::damageSprite(GFXsprite *sprite) {
+  damage.add(sprite->shown.x, sprite->shown.y, sprite->shown.w,
+             sprite->shown.h);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Stable insertion sort of the sprite list by z; the list is
+             short and almost always already in order
+*/
+/**************************************************************************/
+void Adafruit_SpriteLayer::sortSprites(void) {
+  for (uint8_t i = 1; i < numSprites; i++) {
+    GFXsprite *s = sprites[i];
+    uint8_t j = i;
+    for (; (j > 0) && (sprites[j - 1]->z > s->z); j--)
+      sprites[j] = sprites[j - 1];
+    sprites[j] = s;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Rebuild one band of a damaged area for pushDamage():
+             background, then sprites bottom to top
+   @param    band  Scratch canvas; its (0,0) is screen (x,y)
+   @param    x     Left edge, on screen
+   @param    y     Top edge, on screen
+   @param    w     Width to fill
+   @param    h     Height to fill
+   @param    arg   The Adafruit_SpriteLayer
+*/
+/**************************************************************************/
+void Adafruit_SpriteLayer::composeBand(GFXcanvas16 *band, int16_t x,
+                                       int16_t y, int16_t w, int16_t h,
+                                       void *arg) {
+  Adafruit_SpriteLayer *layer = (Adafruit_SpriteLayer *)arg;
+  GFXcanvas16 *background = layer->background;
+  // Background first; the plain color only where the image ends
+  if (!background || (x + w > background->width()) ||
+      (y + h > background->height())) {
+    for (int16_t r = 0; r < h; r++)
+      band->drawFastHLine(0, r, w, layer->backgroundColor);
+  }
+  if (background)
+    band->blit(background, x, y, w, h, 0, 0);
+  // Then sprites, bottom to top
+  for (uint8_t i = 0; i < layer->numSprites; i++) {
+    GFXsprite *s = layer->sprites[i];
+    if (!s->visible)
+      continue;
+    int16_t sx = x - s->x, sy = y - s->y;
+    if ((sx >= s->image->width()) || (sy >= s->image->height()) ||
+        (sx + w <= 0) || (sy + h <= 0))
+      continue; // Not in this band
+    if (s->mask)
+      band->blitMasked(s->image, sx, sy, w, h, 0, 0, s->mask);
+    else if (s->keyed)
+      band->blitKeyed(s->image, sx, sy, w, h, 0, 0, s->key);
+    else
+      band->blit(s->image, sx, sy, w, h, 0, 0);
+  }
+}
+
+#endif // end __AVR_ATtiny85__
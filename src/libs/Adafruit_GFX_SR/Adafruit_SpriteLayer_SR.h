@@ -0,0 +1,74 @@
+/*!
+ * @file Adafruit_SpriteLayer_SR.h
+ *
+ * Part of Adafruit's GFX graphics library. A sprite layer moves a set of
+ * GFXcanvas16 images over a background on an Adafruit_SPITFT display,
+ * repainting only the areas that changed since the previous frame.
+ *
+ * Each damaged area is composited (background, then sprites in z order)
+ * into a small caller-supplied scratch canvas and streamed to the display
+ * inside one address window, so nothing flickers and the whole screen is
+ * never redrawn.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_SPRITELAYER_H_
+#define _ADAFRUIT_SPRITELAYER_H_
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_GFX_SR.h"
+#include "Adafruit_SPITFT_SR.h"
+
+#ifndef SPRITELAYER_MAX_SPRITES
+#define SPRITELAYER_MAX_SPRITES 16 ///< Sprites one layer can hold
+#endif
+
+/// One image placed on an Adafruit_SpriteLayer. The caller owns the
+/// storage; change it only through the layer so damage is tracked.
+typedef struct {
+  GFXcanvas16 *image;     ///< Sprite pixels
+  const GFXcanvas1 *mask; ///< Optional mask, same size as image, or NULL
+  uint16_t key;           ///< Transparent color, used if keyed is set
+  bool keyed;             ///< true if key marks transparent pixels
+  bool visible;           ///< false to hide without removing
+  int16_t x;              ///< Left edge on screen
+  int16_t y;              ///< Top edge on screen
+  int8_t z;               ///< Stacking order, higher is drawn on top
+  GFXrect shown;          ///< Where it was last pushed (layer internal)
+} GFXsprite;
+
+/// Composites sprites over a background and pushes only what changed
+class Adafruit_SpriteLayer {
+public:
+  Adafruit_SpriteLayer(Adafruit_SPITFT *display, GFXcanvas16 *scratch);
+
+  void setBackground(GFXcanvas16 *canvas, uint16_t color = 0);
+  bool addSprite(GFXsprite *sprite);
+  void removeSprite(GFXsprite *sprite);
+  void moveSprite(GFXsprite *sprite, int16_t x, int16_t y);
+  void setSpriteZ(GFXsprite *sprite, int8_t z);
+  void showSprite(GFXsprite *sprite, bool visible);
+  void spriteChanged(GFXsprite *sprite);
+  void invalidate(int16_t x, int16_t y, int16_t w, int16_t h);
+  void invalidateAll(void);
+  void update(void);
+
+protected:
+  void damageSprite(GFXsprite *sprite);
+  void sortSprites(void);
+  static void composeBand(GFXcanvas16 *band, int16_t x, int16_t y, int16_t w,
+                          int16_t h, void *arg);
+
+  Adafruit_SPITFT *display;   ///< Where frames are pushed
+  GFXcanvas16 *scratch;       ///< Composition buffer, rotation 0
+  GFXcanvas16 *background;    ///< Background image at (0,0), or NULL
+  uint16_t backgroundColor;   ///< Fill outside (or instead of) background
+  GFXsprite *sprites[SPRITELAYER_MAX_SPRITES]; ///< Sorted by z
+  uint8_t numSprites;         ///< Entries used in sprites[]
+  GFXdamage damage;           ///< Areas to repaint on next update()
+};
+
+#endif // end __AVR_ATtiny85__
+#endif // end _ADAFRUIT_SPRITELAYER_H_
@@ -149,6 +149,7 @@ void Adafruit_ILI9341::begin(uint32_t freq) {
 
   _width = ILI9341_TFTWIDTH;
   _height = ILI9341_TFTHEIGHT;
+  resetViewport();
 }
 
 /**************************************************************************/
@@ -181,6 +182,7 @@ void Adafruit_ILI9341::setRotation(uint8_t m) {
     _height = ILI9341_TFTWIDTH;
     break;
   }
+  resetViewport(); // Screen edges moved
 
   sendCommand(ILI9341_MADCTL, &m, 1);
 }
@@ -263,6 +265,7 @@ void Adafruit_ILI9341::setAddrWindow(uint16_t x1, uint16_t y1, uint16_t w,
     old_y2 = y2;
   }
   writeCommand(ILI9341_RAMWR); // Write to RAM
+  trackWindow(x1, y1, w, h);   // For the shadow canvas, if any
 }
 
 /**************************************************************************/